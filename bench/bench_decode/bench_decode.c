@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_bench.h"
+#include "test_gbinder.h"
+#include "test_parcels.h"
+
+/* Decoders and dispatch tables are static */
+#include "ril_binder_radio.c"
+
+typedef struct bench_decoder {
+    const char* name;
+    RilBinderRadioDecodeFunc decode;
+} BenchDecoder;
+
+typedef struct bench_decode {
+    RilBinderRadioDecodeFunc decode;
+    GBinderLocalRequest* req;
+    GByteArray* out;
+} BenchDecode;
+
+#define BENCH_DECODER(name) { #name, ril_binder_radio_decode_##name }
+
+static const BenchDecoder bench_decoders[] = {
+    BENCH_DECODER(int32),
+    BENCH_DECODER(int_1),
+    BENCH_DECODER(int_2),
+    BENCH_DECODER(bool_to_int_array),
+    BENCH_DECODER(string),
+    BENCH_DECODER(string_3),
+    BENCH_DECODER(int_array),
+    BENCH_DECODER(byte_array),
+    BENCH_DECODER(byte_array_to_hex),
+    BENCH_DECODER(ims_registration_state),
+    BENCH_DECODER(icc_open_logical_channel),
+    BENCH_DECODER(icc_card_status_1_0),
+    BENCH_DECODER(icc_card_status_1_2),
+    BENCH_DECODER(icc_card_status_1_4),
+    BENCH_DECODER(icc_io_result),
+    BENCH_DECODER(sim_refresh),
+    BENCH_DECODER(voice_reg_state),
+    BENCH_DECODER(data_reg_state),
+    BENCH_DECODER(data_reg_state_1_4),
+    BENCH_DECODER(operator_info_list),
+    BENCH_DECODER(pref_network_type),
+    BENCH_DECODER(pref_network_type_bitmap),
+    BENCH_DECODER(signal_strength),
+    BENCH_DECODER(signal_strength_1_2),
+    BENCH_DECODER(signal_strength_1_4),
+    BENCH_DECODER(radio_capability),
+    BENCH_DECODER(cell_info_list),
+    BENCH_DECODER(cell_info_list_1_2),
+    BENCH_DECODER(cell_info_list_1_4),
+    BENCH_DECODER(call_list),
+    BENCH_DECODER(call_list_1_2),
+    BENCH_DECODER(last_call_fail_cause),
+    BENCH_DECODER(call_forward_info_array),
+    BENCH_DECODER(call_waiting),
+    BENCH_DECODER(supp_svc_notification),
+    BENCH_DECODER(ussd),
+    BENCH_DECODER(device_identity),
+    BENCH_DECODER(sms_send_result),
+    BENCH_DECODER(gsm_broadcast_sms_config),
+    BENCH_DECODER(setup_data_call_result),
+    BENCH_DECODER(setup_data_call_result_1_4),
+    BENCH_DECODER(data_call_list),
+    BENCH_DECODER(data_call_list_1_4)
+};
+
+static
+const BenchDecoder*
+bench_decoder_find(
+    RilBinderRadioDecodeFunc decode)
+{
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS(bench_decoders); i++) {
+        if (bench_decoders[i].decode == decode) {
+            return bench_decoders + i;
+        }
+    }
+    return NULL;
+}
+
+/* Every decoder referenced by the dispatch tables must be covered */
+static
+void
+bench_decode_check_coverage(
+    void)
+{
+    guint i, k;
+
+    for (i = 0; i < G_N_ELEMENTS(ril_binder_radio_interfaces); i++) {
+        const RilBinderRadioInterfaceDesc* desc =
+            ril_binder_radio_interfaces + i;
+
+        for (k = 0; k < desc->num_calls; k++) {
+            const RilBinderRadioCall* call = desc->calls + k;
+
+            if (call->decode && !bench_decoder_find(call->decode)) {
+                test_bench_fail("No decoder benchmark for %s", call->name);
+            }
+        }
+        for (k = 0; k < desc->num_events; k++) {
+            const RilBinderRadioEvent* event = desc->events + k;
+
+            if (event->decode && !bench_decoder_find(event->decode)) {
+                test_bench_fail("No decoder benchmark for %s", event->name);
+            }
+        }
+    }
+}
+
+static
+gboolean
+bench_decode_once(
+    gpointer user_data)
+{
+    BenchDecode* bench = user_data;
+    GBinderReader reader;
+
+    /* Output buffers are pooled, i.e. reused */
+    test_gbinder_reader_init(&reader, bench->req);
+    g_byte_array_set_size(bench->out, 0);
+    return bench->decode(&reader, bench->out);
+}
+
+/*
+ * Decodes into a new buffer, the way a pooled buffer gets filled for
+ * the first time. Each reallocation is the output buffer regrowing.
+ */
+static
+gboolean
+bench_decode_once_fresh(
+    gpointer user_data)
+{
+    BenchDecode* bench = user_data;
+    GByteArray* out = g_byte_array_new();
+    GBinderReader reader;
+    gboolean ok;
+
+    test_gbinder_reader_init(&reader, bench->req);
+    ok = bench->decode(&reader, out);
+    g_byte_array_free(out, TRUE);
+    return ok;
+}
+
+static
+void
+bench_decode(
+    const BenchDecoder* decoder)
+{
+    const TestParcelType* type = test_parcel_type_find(decoder->name);
+    int size;
+
+    if (!type) {
+        test_bench_fail("No parcel for %s", decoder->name);
+        return;
+    }
+    for (size = 0; size < TEST_PARCEL_SIZE_COUNT; size++) {
+        char* name = g_strdup_printf("Decode/%s/%s", decoder->name,
+            test_parcel_size_name(size));
+        BenchDecode bench;
+        TestBenchResult result;
+
+        bench.decode = decoder->decode;
+        bench.req = test_parcel_new(type, size);
+        bench.out = g_byte_array_new();
+        test_bench_run(name, bench_decode_once, &bench, &result);
+        g_free(name);
+
+        name = g_strdup_printf("Decode/%s/%s/fresh", decoder->name,
+            test_parcel_size_name(size));
+        test_bench_run(name, bench_decode_once_fresh, &bench, &result);
+        g_free(name);
+
+        g_byte_array_free(bench.out, TRUE);
+        gbinder_local_request_unref(bench.req);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    guint i;
+
+    test_bench_init(argc, argv);
+    bench_decode_check_coverage();
+    for (i = 0; i < G_N_ELEMENTS(bench_decoders); i++) {
+        bench_decode(bench_decoders + i);
+    }
+    return test_bench_exit();
+}
+
+/*
+ * Local Variables:
+ * mode: C
+ * c-basic-offset: 4
+ * indent-tabs-mode: nil
+ * End:
+ */
@@ -0,0 +1,344 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Request, response and indication lookup, using the merged dense
+ * tables versus the per-version hash tables walked from the negotiated
+ * version down to 1.0 (which is how it used to be done). Each operation
+ * is one lookup, the codes are taken in turn from all the dispatch
+ * tables plus one unknown code.
+ */
+
+#include "test_bench.h"
+
+/* Dispatch tables are static */
+#include "ril_binder_radio.c"
+
+typedef enum bench_dispatch_kind {
+    BENCH_DISPATCH_REQ,
+    BENCH_DISPATCH_RESP,
+    BENCH_DISPATCH_UNSOL,
+    BENCH_DISPATCH_KIND_COUNT
+} BENCH_DISPATCH_KIND;
+
+static const char* const bench_dispatch_kind_names[] = {
+    "req", "resp", "unsol"
+};
+
+G_STATIC_ASSERT(G_N_ELEMENTS(bench_dispatch_kind_names) ==
+    BENCH_DISPATCH_KIND_COUNT);
+
+typedef struct bench_dispatch_maps {
+    GHashTable* map[BENCH_DISPATCH_KIND_COUNT][RADIO_INTERFACE_COUNT];
+} BenchDispatchMaps;
+
+typedef struct bench_dispatch {
+    const BenchDispatchMaps* maps;
+    const RilBinderRadioTables* tables;
+    BENCH_DISPATCH_KIND kind;
+    RADIO_INTERFACE version;
+    GArray* codes;
+    guint next;
+    gconstpointer found;
+} BenchDispatch;
+
+static
+GHashTable*
+bench_dispatch_map(
+    BenchDispatchMaps* maps,
+    BENCH_DISPATCH_KIND kind,
+    RADIO_INTERFACE version)
+{
+    GHashTable** map = maps->map[kind] + version;
+
+    if (!*map) {
+        *map = g_hash_table_new(g_direct_hash, g_direct_equal);
+    }
+    return *map;
+}
+
+/* Same as the per-version maps that the dense tables have replaced */
+static
+void
+bench_dispatch_maps_init(
+    BenchDispatchMaps* maps)
+{
+    guint i, k;
+
+    memset(maps, 0, sizeof(*maps));
+    for (i = 0; i < G_N_ELEMENTS(ril_binder_radio_interfaces); i++) {
+        const RilBinderRadioInterfaceDesc* desc =
+            ril_binder_radio_interfaces + i;
+
+        for (k = 0; k < desc->num_calls; k++) {
+            const RilBinderRadioCall* call = desc->calls + k;
+
+            if (call->req_tx) {
+                g_hash_table_insert(bench_dispatch_map(maps,
+                    BENCH_DISPATCH_REQ, desc->version),
+                    GINT_TO_POINTER(call->code), (gpointer)call);
+            }
+            if (call->resp_tx) {
+                g_hash_table_insert(bench_dispatch_map(maps,
+                    BENCH_DISPATCH_RESP, desc->version),
+                    GINT_TO_POINTER(call->resp_tx), (gpointer)call);
+            }
+        }
+        for (k = 0; k < desc->num_events; k++) {
+            const RilBinderRadioEvent* event = desc->events + k;
+
+            g_hash_table_insert(bench_dispatch_map(maps,
+                BENCH_DISPATCH_UNSOL, desc->version),
+                GINT_TO_POINTER(event->unsol_tx), (gpointer)event);
+        }
+    }
+}
+
+static
+void
+bench_dispatch_maps_clear(
+    BenchDispatchMaps* maps)
+{
+    guint i, k;
+
+    for (i = 0; i < BENCH_DISPATCH_KIND_COUNT; i++) {
+        for (k = 0; k < RADIO_INTERFACE_COUNT; k++) {
+            if (maps->map[i][k]) {
+                g_hash_table_destroy(maps->map[i][k]);
+            }
+        }
+    }
+}
+
+/* All the codes of the given kind, followed by an unknown one */
+static
+GArray*
+bench_dispatch_codes(
+    BENCH_DISPATCH_KIND kind)
+{
+    GArray* codes = g_array_new(FALSE, FALSE, sizeof(guint));
+    guint i, k, max = 0;
+
+    for (i = 0; i < G_N_ELEMENTS(ril_binder_radio_interfaces); i++) {
+        const RilBinderRadioInterfaceDesc* desc =
+            ril_binder_radio_interfaces + i;
+
+        if (kind == BENCH_DISPATCH_UNSOL) {
+            for (k = 0; k < desc->num_events; k++) {
+                const guint code = desc->events[k].unsol_tx;
+
+                g_array_append_val(codes, code);
+                max = MAX(max, code);
+            }
+        } else {
+            for (k = 0; k < desc->num_calls; k++) {
+                const RilBinderRadioCall* call = desc->calls + k;
+                guint code = 0;
+
+                if (kind == BENCH_DISPATCH_REQ && call->req_tx) {
+                    code = call->code;
+                } else if (kind == BENCH_DISPATCH_RESP && call->resp_tx) {
+                    code = call->resp_tx;
+                } else {
+                    continue;
+                }
+                g_array_append_val(codes, code);
+                max = MAX(max, code);
+            }
+        }
+    }
+    max++;
+    g_array_append_val(codes, max);
+    return codes;
+}
+
+static
+gconstpointer
+bench_dispatch_hash_lookup(
+    const BenchDispatchMaps* maps,
+    BENCH_DISPATCH_KIND kind,
+    RADIO_INTERFACE version,
+    guint code)
+{
+    int i = version;
+
+    while (i >= 0) {
+        GHashTable* map = maps->map[kind][i--];
+
+        if (map) {
+            gconstpointer found = g_hash_table_lookup(map,
+                GINT_TO_POINTER(code));
+
+            if (found) {
+                return found;
+            }
+        }
+    }
+    return NULL;
+}
+
+static
+gconstpointer
+bench_dispatch_dense_lookup(
+    const RilBinderRadioTables* tables,
+    BENCH_DISPATCH_KIND kind,
+    guint code)
+{
+    switch (kind) {
+    case BENCH_DISPATCH_REQ:
+        return ril_binder_radio_tables_req(tables, code);
+    case BENCH_DISPATCH_RESP:
+        return ril_binder_radio_tables_resp(tables, code);
+    case BENCH_DISPATCH_UNSOL:
+        return ril_binder_radio_tables_unsol(tables, code);
+    case BENCH_DISPATCH_KIND_COUNT:
+        break;
+    }
+    return NULL;
+}
+
+static
+guint
+bench_dispatch_next_code(
+    BenchDispatch* bench)
+{
+    const guint code = g_array_index(bench->codes, guint, bench->next++);
+
+    if (bench->next == bench->codes->len) {
+        bench->next = 0;
+    }
+    return code;
+}
+
+static
+gboolean
+bench_dispatch_hash(
+    gpointer user_data)
+{
+    BenchDispatch* bench = user_data;
+
+    bench->found = bench_dispatch_hash_lookup(bench->maps, bench->kind,
+        bench->version, bench_dispatch_next_code(bench));
+    return TRUE;
+}
+
+static
+gboolean
+bench_dispatch_dense(
+    gpointer user_data)
+{
+    BenchDispatch* bench = user_data;
+
+    bench->found = bench_dispatch_dense_lookup(bench->tables, bench->kind,
+        bench_dispatch_next_code(bench));
+    return TRUE;
+}
+
+/* Both ways must find the same thing */
+static
+void
+bench_dispatch_check(
+    const BenchDispatch* bench)
+{
+    guint i;
+
+    for (i = 0; i < bench->codes->len; i++) {
+        const guint code = g_array_index(bench->codes, guint, i);
+
+        if (bench_dispatch_hash_lookup(bench->maps, bench->kind,
+            bench->version, code) != bench_dispatch_dense_lookup
+            (bench->tables, bench->kind, code)) {
+            test_bench_fail("%s %s %u lookup mismatch",
+                ril_binder_radio_interface_name(bench->version),
+                bench_dispatch_kind_names[bench->kind], code);
+        }
+    }
+}
+
+static
+void
+bench_dispatch(
+    const BenchDispatchMaps* maps,
+    RADIO_INTERFACE version,
+    BENCH_DISPATCH_KIND kind)
+{
+    const char* iface = ril_binder_radio_interface_name(version);
+    const char* what = bench_dispatch_kind_names[kind];
+    RilBinderRadioTables* tables = ril_binder_radio_tables_get(version);
+    TestBenchResult result;
+    BenchDispatch bench;
+    char* name;
+
+    memset(&bench, 0, sizeof(bench));
+    bench.maps = maps;
+    bench.tables = tables;
+    bench.kind = kind;
+    bench.version = version;
+    bench.codes = bench_dispatch_codes(kind);
+    bench_dispatch_check(&bench);
+
+    name = g_strdup_printf("Dispatch/%s/%s/hash", iface, what);
+    test_bench_run(name, bench_dispatch_hash, &bench, &result);
+    g_free(name);
+
+    bench.next = 0;
+    name = g_strdup_printf("Dispatch/%s/%s/dense", iface, what);
+    test_bench_run(name, bench_dispatch_dense, &bench, &result);
+    g_free(name);
+
+    g_array_free(bench.codes, TRUE);
+    ril_binder_radio_tables_unref(tables);
+}
+
+int main(int argc, char* argv[])
+{
+    BenchDispatchMaps maps;
+    RADIO_INTERFACE v;
+    int kind;
+
+    test_bench_init(argc, argv);
+    bench_dispatch_maps_init(&maps);
+    for (v = RADIO_INTERFACE_1_0; v < RADIO_INTERFACE_COUNT; v++) {
+        for (kind = 0; kind < BENCH_DISPATCH_KIND_COUNT; kind++) {
+            bench_dispatch(&maps, v, kind);
+        }
+    }
+    bench_dispatch_maps_clear(&maps);
+    return test_bench_exit();
+}
+
+/*
+ * Local Variables:
+ * mode: C
+ * c-basic-offset: 4
+ * indent-tabs-mode: nil
+ * End:
+ */
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_bench.h"
+#include "test_gbinder.h"
+#include "test_requests.h"
+
+/* Encoders and dispatch tables are static */
+#include "ril_binder_radio.c"
+
+typedef
+gboolean
+(*BenchEncodeFunc)(
+    GRilIoRequest* in,
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx);
+
+typedef struct bench_encoder {
+    const char* name;
+    BenchEncodeFunc encode;
+} BenchEncoder;
+
+typedef struct bench_encode {
+    BenchEncodeFunc encode;
+    RilBinderRadioArenaPool* pool;
+    GRilIoRequest* in;
+    GBinderLocalRequest* out;
+} BenchEncode;
+
+#define BENCH_ENCODER(name) { #name, ril_binder_radio_encode_##name }
+
+static const BenchEncoder bench_encoders[] = {
+    BENCH_ENCODER(serial),
+    BENCH_ENCODER(int),
+    BENCH_ENCODER(bool),
+    BENCH_ENCODER(ints),
+    BENCH_ENCODER(string),
+    BENCH_ENCODER(strings),
+    BENCH_ENCODER(ints_to_bool_int),
+    BENCH_ENCODER(device_state),
+    {
+        "map_screen_state_to_device_state",
+        ril_binder_radio_map_screen_state_to_device_state
+    },
+    BENCH_ENCODER(dial),
+    BENCH_ENCODER(call_forward_info),
+    BENCH_ENCODER(get_facility_lock),
+    BENCH_ENCODER(set_facility_lock),
+    BENCH_ENCODER(gsm_sms_message),
+    BENCH_ENCODER(sms_write_args),
+    BENCH_ENCODER(gsm_broadcast_sms_config),
+    BENCH_ENCODER(icc_io),
+    BENCH_ENCODER(uicc_sub),
+    BENCH_ENCODER(icc_open_logical_channel),
+    BENCH_ENCODER(icc_transmit_apdu_logical_channel),
+    BENCH_ENCODER(radio_capability),
+    BENCH_ENCODER(deactivate_data_call),
+    BENCH_ENCODER(deactivate_data_call_1_2),
+    BENCH_ENCODER(setup_data_call),
+    BENCH_ENCODER(setup_data_call_1_2),
+    BENCH_ENCODER(initial_attach_apn),
+    BENCH_ENCODER(data_profiles)
+};
+
+static
+const BenchEncoder*
+bench_encoder_find(
+    BenchEncodeFunc encode)
+{
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS(bench_encoders); i++) {
+        if (bench_encoders[i].encode == encode) {
+            return bench_encoders + i;
+        }
+    }
+    return NULL;
+}
+
+/* Every encoder referenced by the dispatch tables must be covered */
+static
+void
+bench_encode_check_coverage(
+    void)
+{
+    guint i, k;
+
+    for (i = 0; i < G_N_ELEMENTS(ril_binder_radio_interfaces); i++) {
+        const RilBinderRadioInterfaceDesc* desc =
+            ril_binder_radio_interfaces + i;
+
+        for (k = 0; k < desc->num_calls; k++) {
+            const RilBinderRadioCall* call = desc->calls + k;
+
+            if (call->encode && !bench_encoder_find(call->encode)) {
+                test_bench_fail("No encoder benchmark for %s", call->name);
+            }
+        }
+    }
+}
+
+/* Same as ril_binder_radio_run_encoder() */
+static
+gboolean
+bench_encode_once(
+    gpointer user_data)
+{
+    BenchEncode* bench = user_data;
+    RilBinderRadioEncodeCtx ctx;
+    gboolean ok;
+
+    /* As if the previous request has been sent and freed */
+    test_gbinder_local_request_reset(bench->out);
+    ctx.pool = bench->pool;
+    ctx.arena = NULL;
+    ok = bench->encode(bench->in, bench->out, &ctx);
+    if (ctx.arena) {
+        gbinder_local_request_cleanup(bench->out,
+            ril_binder_radio_arena_free, ctx.arena);
+    }
+    return ok;
+}
+
+static
+void
+bench_encode(
+    const BenchEncoder* encoder,
+    RilBinderRadioArenaPool* pool)
+{
+    const TestRequestType* type = test_request_type_find(encoder->name);
+    int size;
+
+    if (!type) {
+        test_bench_fail("No request for %s", encoder->name);
+        return;
+    }
+    for (size = 0; size < TEST_PARCEL_SIZE_COUNT; size++) {
+        char* name = g_strdup_printf("Encode/%s/%s", encoder->name,
+            test_parcel_size_name(size));
+        BenchEncode bench;
+        TestBenchResult result;
+
+        bench.encode = encoder->encode;
+        bench.pool = pool;
+        bench.in = test_request_new(type, size);
+        bench.out = test_gbinder_local_request_new();
+        test_bench_run(name, bench_encode_once, &bench, &result);
+        gbinder_local_request_unref(bench.out);
+        grilio_request_unref(bench.in);
+        g_free(name);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    RilBinderRadioMem* mem;
+    RilBinderRadioArenaPool* pool;
+    guint i;
+
+    test_bench_init(argc, argv);
+    mem = ril_binder_radio_mem_new();
+    pool = ril_binder_radio_arena_pool_new(mem);
+    bench_encode_check_coverage();
+    for (i = 0; i < G_N_ELEMENTS(bench_encoders); i++) {
+        bench_encode(bench_encoders + i, pool);
+    }
+    ril_binder_radio_arena_pool_unref(pool);
+    ril_binder_radio_mem_unref(mem);
+    return test_bench_exit();
+}
+
+/*
+ * Local Variables:
+ * mode: C
+ * c-basic-offset: 4
+ * indent-tabs-mode: nil
+ * End:
+ */
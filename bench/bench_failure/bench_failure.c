@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Stress test for the generic failure path. Each operation submits a
+ * burst of requests that fail locally, either because the RIL command
+ * is unknown or because its arguments don't encode, and then runs the
+ * main loop until all of them have been completed.
+ *
+ * Failures are queued in a preallocated ring and completed by a single
+ * idle callback, so the number of allocations per burst must not grow
+ * with the size of the burst. That's checked for unknown commands. Known
+ * ones also go through the latency tracker and the RadioInstance, which
+ * are not subject to this check.
+ */
+
+#include "test_bench.h"
+#include "test_radio_instance.h"
+
+/* ril_binder_radio_send() is static */
+#include "ril_binder_radio.c"
+
+#define BENCH_UNKNOWN_CODE (0xffff)
+
+/* Takes one int, fails if it's missing */
+#define BENCH_BAD_ARGS_CODE RIL_REQUEST_SET_SUPP_SVC_NOTIFICATION
+
+typedef struct bench_failure {
+    RilBinderRadio* self;
+    guint code;
+    GRilIoRequest** reqs;
+    guint count;
+} BenchFailure;
+
+static const guint bench_failure_bursts[] = { 1, 16, 256 };
+
+static
+gboolean
+bench_failure_once(
+    gpointer user_data)
+{
+    BenchFailure* bench = user_data;
+    GRilIoTransport* transport = &bench->self->parent;
+    guint i;
+
+    for (i = 0; i < bench->count; i++) {
+        if (ril_binder_radio_send(transport, bench->reqs[i], bench->code) !=
+            GRILIO_SEND_OK) {
+            return FALSE;
+        }
+    }
+    while (g_main_context_iteration(NULL, FALSE));
+    return !bench->self->priv->failures.count;
+}
+
+static
+void
+bench_failure(
+    RilBinderRadio* self,
+    const char* what,
+    guint code,
+    gboolean check)
+{
+    gboolean have_base = FALSE;
+    gdouble base = 0;
+    guint i, k;
+
+    for (i = 0; i < G_N_ELEMENTS(bench_failure_bursts); i++) {
+        const guint count = bench_failure_bursts[i];
+        char* name = g_strdup_printf("GenericFailure/%s/%u", what, count);
+        TestBenchResult result;
+        BenchFailure bench;
+
+        bench.self = self;
+        bench.code = code;
+        bench.count = count;
+        bench.reqs = g_new(GRilIoRequest*, count);
+        for (k = 0; k < count; k++) {
+            /* Empty requests, which is what breaks the encoder */
+            bench.reqs[k] = grilio_request_new();
+        }
+
+        if (test_bench_run(name, bench_failure_once, &bench, &result) &&
+            result.n && check) {
+            if (!i) {
+                base = result.allocs_per_op;
+                have_base = TRUE;
+            } else if (have_base && result.allocs_per_op > base + 0.5) {
+                test_bench_fail("%s: %.2f allocs per burst of %u, "
+                    "%.2f per burst of %u", name, result.allocs_per_op,
+                    count, base, bench_failure_bursts[0]);
+            }
+        }
+
+        for (k = 0; k < count; k++) {
+            grilio_request_unref(bench.reqs[k]);
+        }
+        g_free(bench.reqs);
+        g_free(name);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    GHashTable* args;
+    GRilIoTransport* transport;
+    RadioInstance* radio;
+
+    test_bench_init(argc, argv);
+    args = g_hash_table_new(g_str_hash, g_str_equal);
+    transport = ril_binder_radio_new(args);
+    g_hash_table_destroy(args);
+    radio = test_radio_instance_last();
+    if (transport && radio) {
+        RilBinderRadio* self = RIL_BINDER_RADIO(transport);
+
+        test_radio_instance_set_record(radio, FALSE);
+        test_radio_instance_connect(radio);
+        bench_failure(self, "unknown", BENCH_UNKNOWN_CODE, TRUE);
+        bench_failure(self, "encode", BENCH_BAD_ARGS_CODE, FALSE);
+    } else {
+        test_bench_fail("Failed to create the transport");
+    }
+    grilio_transport_unref(transport);
+    return test_bench_exit();
+}
+
+/*
+ * Local Variables:
+ * mode: C
+ * c-basic-offset: 4
+ * indent-tabs-mode: nil
+ * End:
+ */
@@ -39,6 +39,146 @@ GRilIoTransport*
 ril_binder_radio_new(
     GHashTable* args);
 
+/*
+ * Request latency statistics, per IRadio call. Histogram bucket i
+ * counts latencies not exceeding ril_binder_radio_latency_bucket_limit(i)
+ * microseconds (the last bucket is unlimited). Ack latency is the time
+ * until acknowledgeRequest, response latency is the time until the final
+ * response. OEM hook requests are reported as "oemHookRaw".
+ */
+
+#define RIL_BINDER_RADIO_LATENCY_BUCKETS (12)
+
+typedef struct ril_binder_radio_latency {
+    const char* name;
+    guint ack_count;
+    guint resp_count;
+    guint64 ack_total_us;
+    guint64 resp_total_us;
+    guint resp_max_us;
+    guint ack[RIL_BINDER_RADIO_LATENCY_BUCKETS];
+    guint resp[RIL_BINDER_RADIO_LATENCY_BUCKETS];
+} RilBinderRadioLatency;
+
+guint
+ril_binder_radio_latency_bucket_limit(
+    guint bucket);
+
+gboolean
+ril_binder_radio_latency_get(
+    GRilIoTransport* transport,
+    const char* name,
+    RilBinderRadioLatency* latency);
+
+/* Returns g_free'able array of count elements (NULL if there's none) */
+RilBinderRadioLatency*
+ril_binder_radio_latency_list(
+    GRilIoTransport* transport,
+    guint* count);
+
+void
+ril_binder_radio_latency_reset(
+    GRilIoTransport* transport);
+
+/*
+ * Indication statistics, per RADIO_IND code. Codes not known to the
+ * plugin at all are accumulated under RIL_BINDER_RADIO_IND_OTHER.
+ * last_minute is the number of indications received during the last
+ * 60 seconds (with 10 second granularity).
+ */
+
+#define RIL_BINDER_RADIO_IND_OTHER (G_MAXUINT)
+
+typedef struct ril_binder_radio_ind_stats {
+    guint code;
+    guint count;
+    guint unknown;
+    guint failed;
+    guint64 bytes;
+    guint last_minute;
+} RilBinderRadioIndStats;
+
+/* Busiest codes first, returns g_free'able array (NULL if there's none) */
+RilBinderRadioIndStats*
+ril_binder_radio_ind_stats_top(
+    GRilIoTransport* transport,
+    guint max,
+    guint* count);
+
+void
+ril_binder_radio_ind_stats_reset(
+    GRilIoTransport* transport);
+
+/*
+ * Duplicate indication suppression (see dedupWindow), one entry per
+ * deduplicated RIL_UNSOL_* code, including the ones which haven't been
+ * suppressed yet. Returns g_free'able array (NULL if deduplication isn't
+ * available).
+ */
+
+typedef struct ril_binder_radio_dedup_stats {
+    guint code;
+    guint suppressed;
+} RilBinderRadioDedupStats;
+
+RilBinderRadioDedupStats*
+ril_binder_radio_dedup_stats(
+    GRilIoTransport* transport,
+    guint* count);
+
+void
+ril_binder_radio_dedup_stats_reset(
+    GRilIoTransport* transport);
+
+/*
+ * Batch mode statistics (see "batch"), the number of flushes and their
+ * distribution by the number of requests submitted together. Bucket i
+ * counts batches of up to ril_binder_radio_batch_bucket_limit(i)
+ * requests (the last bucket is unlimited). Returns FALSE if the
+ * transport isn't a binder one.
+ */
+
+#define RIL_BINDER_RADIO_BATCH_BUCKETS (7)
+
+typedef struct ril_binder_radio_batch_stats {
+    guint flushes;
+    guint hist[RIL_BINDER_RADIO_BATCH_BUCKETS];
+} RilBinderRadioBatchStats;
+
+guint
+ril_binder_radio_batch_bucket_limit(
+    guint bucket);
+
+gboolean
+ril_binder_radio_batch_stats(
+    GRilIoTransport* transport,
+    RilBinderRadioBatchStats* stats);
+
+void
+ril_binder_radio_batch_stats_reset(
+    GRilIoTransport* transport);
+
+/*
+ * Bytes owned by the transport: output buffers, data handed over to
+ * outgoing requests and dispatch tables. Returns FALSE if the transport
+ * isn't a binder one.
+ */
+gboolean
+ril_binder_radio_memory_usage(
+    GRilIoTransport* transport,
+    gsize* current,
+    gsize* peak);
+
+/* Logs encoder/decoder costs, does nothing unless built with PROFILE=1 */
+void
+ril_binder_radio_profile_report(
+    void);
+
+/* Dumps flight recorders of the slots which have recorderDir set */
+void
+ril_binder_radio_dump_recorders(
+    void);
+
 /* Logging */
 extern GLogModule ril_binder_radio_log;
 
@@ -72,6 +72,8 @@ GType ril_binder_radio_get_type(void);
 #define RIL_TYPE_BINDER_RADIO (ril_binder_radio_get_type())
 #define RIL_BINDER_RADIO(obj) G_TYPE_CHECK_INSTANCE_CAST((obj), \
         RIL_TYPE_BINDER_RADIO, RilBinderRadio)
+#define RIL_BINDER_IS_RADIO(obj) G_TYPE_CHECK_INSTANCE_TYPE((obj), \
+        RIL_TYPE_BINDER_RADIO)
 #define RIL_BINDER_RADIO_GET_CLASS(obj) \
         G_TYPE_INSTANCE_GET_CLASS((obj), RIL_TYPE_BINDER_RADIO, \
         RilBinderRadioClass)
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*
+ * Allocation counter for the profiling build. Not linked into the
+ * library or the plugin, it's built as a separate object to be loaded
+ * with LD_PRELOAD, e.g.
+ *
+ *   LD_PRELOAD=build/profile/libril-binder-alloc.so ofonod -n
+ *
+ * The library finds ril_binder_alloc_count() at runtime and reports
+ * allocations per encoder/decoder call. Counters are per thread.
+ *
+ * Benchmarks and tests link this file statically and also look at the
+ * number of bytes requested and the number of times an existing block
+ * had to be reallocated (i.e. a buffer has grown).
+ *
+ * Aligned allocations are counted too, that's where GSlice gets its
+ * memory from unless G_SLICE=always-malloc is set.
+ */
+
+#include <errno.h>
+#include <stddef.h>
+
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t n, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+extern void* __libc_memalign(size_t alignment, size_t size);
+
+static __thread unsigned long ril_binder_alloc_counter;
+static __thread unsigned long ril_binder_alloc_byte_counter;
+static __thread unsigned long ril_binder_alloc_realloc_counter;
+
+unsigned long
+ril_binder_alloc_count(
+    void)
+{
+    return ril_binder_alloc_counter;
+}
+
+unsigned long
+ril_binder_alloc_bytes(
+    void)
+{
+    return ril_binder_alloc_byte_counter;
+}
+
+unsigned long
+ril_binder_alloc_reallocs(
+    void)
+{
+    return ril_binder_alloc_realloc_counter;
+}
+
+void*
+malloc(
+    size_t size)
+{
+    ril_binder_alloc_counter++;
+    ril_binder_alloc_byte_counter += size;
+    return __libc_malloc(size);
+}
+
+void*
+calloc(
+    size_t n,
+    size_t size)
+{
+    ril_binder_alloc_counter++;
+    ril_binder_alloc_byte_counter += n * size;
+    return __libc_calloc(n, size);
+}
+
+void*
+realloc(
+    void* ptr,
+    size_t size)
+{
+    ril_binder_alloc_counter++;
+    ril_binder_alloc_byte_counter += size;
+    if (ptr) {
+        /* realloc(NULL, size) is just another malloc */
+        ril_binder_alloc_realloc_counter++;
+    }
+    return __libc_realloc(ptr, size);
+}
+
+void*
+memalign(
+    size_t alignment,
+    size_t size)
+{
+    ril_binder_alloc_counter++;
+    ril_binder_alloc_byte_counter += size;
+    return __libc_memalign(alignment, size);
+}
+
+void*
+aligned_alloc(
+    size_t alignment,
+    size_t size)
+{
+    return memalign(alignment, size);
+}
+
+int
+posix_memalign(
+    void** ptr,
+    size_t alignment,
+    size_t size)
+{
+    void* block;
+
+    /* Power of two and a multiple of sizeof(void*) */
+    if (!alignment || (alignment & (alignment - 1)) ||
+        (alignment % sizeof(void*))) {
+        return EINVAL;
+    }
+    block = memalign(alignment, size);
+    if (!block && size) {
+        return ENOMEM;
+    }
+    *ptr = block;
+    return 0;
+}
+
+/*
+ * Local Variables:
+ * mode: C
+ * c-basic-offset: 4
+ * indent-tabs-mode: nil
+ * End:
+ */
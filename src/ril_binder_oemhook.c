@@ -31,6 +31,7 @@
  */
 
 #include "ril_binder_oemhook.h"
+#include "ril_binder_trace.h"
 #include "ril_binder_log.h"
 
 #include <radio_instance.h>
@@ -52,6 +53,8 @@ struct ril_binder_oemhook {
     gulong death_id;
 };
 
+RIL_BINDER_TRACE_SEMAPHORE(oemhook_send_request_raw);
+
 G_DEFINE_TYPE(RilBinderOemHook, ril_binder_oemhook, G_TYPE_OBJECT)
 #define RIL_BINDER_TYPE_OEMHOOK (ril_binder_oemhook_get_type())
 #define RIL_BINDER_OEMHOOK(obj) (G_TYPE_CHECK_INSTANCE_CAST((obj), \
@@ -307,6 +310,8 @@ ril_binder_oemhook_send_request_raw(
     id = gbinder_client_transact(self->client, OEMHOOK_REQ_SEND_REQUEST_RAW,
         GBINDER_TX_FLAG_ONEWAY, req, NULL, NULL, NULL);
 
+    RIL_BINDER_TRACE3(oemhook_send_request_raw, grilio_request_serial(in),
+        grilio_request_size(in), id != 0);
     gbinder_local_request_unref(req);
     return (id != 0);
 }
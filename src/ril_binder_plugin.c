@@ -80,8 +80,13 @@ void
 ril_binder_plugin_ril_binder_log_notify(
     struct ofono_debug_desc* desc)
 {
-    ril_binder_radio_log.level = (desc->flags & OFONO_DEBUG_FLAG_PRINT) ?
-        GLOG_LEVEL_VERBOSE : GLOG_LEVEL_INHERIT;
+    if (desc->flags & OFONO_DEBUG_FLAG_PRINT) {
+        ril_binder_radio_log.level = GLOG_LEVEL_VERBOSE;
+        /* Enabling ril-binder debugging also dumps flight recorders */
+        ril_binder_radio_dump_recorders();
+    } else {
+        ril_binder_radio_log.level = GLOG_LEVEL_INHERIT;
+    }
 }
 
 static struct ofono_debug_desc grilio_binder_log_debug OFONO_DEBUG_ATTR = {
@@ -127,6 +132,7 @@ ril_binder_plugin_exit()
 {
     DBG("");
     ofono_ril_transport_unregister(&ril_binder_transport);
+    ril_binder_radio_profile_report();
 }
 
 OFONO_PLUGIN_DEFINE(ril_binder, "RIL binder transport plugin",
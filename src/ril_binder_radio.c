@@ -36,6 +36,8 @@
 #include "ril_binder_radio.h"
 #include "ril_binder_radio_impl.h"
 #include "ril_binder_oemhook.h"
+#include "ril_binder_recorder.h"
+#include "ril_binder_trace.h"
 #include "ril_binder_log.h"
 
 #include <ofono/ril-constants.h>
@@ -53,17 +55,46 @@
 #include <gutil_idlequeue.h>
 #include <gutil_misc.h>
 
+#ifdef RIL_BINDER_PROFILE
+#  include <dlfcn.h>
+#  include <time.h>
+#endif
+
 /* Logging */
 GLOG_MODULE_DEFINE("grilio-binder");
 
+/* USDT semaphores, see ril_binder_trace.h */
+RIL_BINDER_TRACE_SEMAPHORE(send);
+RIL_BINDER_TRACE_SEMAPHORE(response);
+RIL_BINDER_TRACE_SEMAPHORE(indication);
+RIL_BINDER_TRACE_SEMAPHORE(decode_response);
+RIL_BINDER_TRACE_SEMAPHORE(decode_indication);
+RIL_BINDER_TRACE_SEMAPHORE(generic_failure);
+
 #define RIL_BINDER_KEY_MODEM      "modem"
 #define RIL_BINDER_KEY_DEV        "dev"
 #define RIL_BINDER_KEY_NAME       "name"
 #define RIL_BINDER_KEY_INTERFACE  "interface"
+#define RIL_BINDER_KEY_ASYNC      "async"
+#define RIL_BINDER_KEY_QUEUE      "queue"
+#define RIL_BINDER_KEY_BATCH      "batch"
+#define RIL_BINDER_KEY_BUFFER_TRIM "bufferTrim"
+#define RIL_BINDER_KEY_SIGNAL_INTERVAL   "signalInterval"
+#define RIL_BINDER_KEY_SIGNAL_DBM_DELTA  "signalDbmDelta"
+#define RIL_BINDER_KEY_SIGNAL_RSRP_DELTA "signalRsrpDelta"
+#define RIL_BINDER_KEY_SIGNAL_RSRQ_DELTA "signalRsrqDelta"
+#define RIL_BINDER_KEY_DEDUP_WINDOW      "dedupWindow"
+#define RIL_BINDER_KEY_RECORDER_DIR      "recorderDir"
+#define RIL_BINDER_KEY_APN_CACHE         "apnCache"
 
 #define RIL_BINDER_DEFAULT_MODEM     "/ril_0"
 #define RIL_BINDER_DEFAULT_DEV       "/dev/hwbinder"
 #define RIL_BINDER_DEFAULT_NAME      "slot1"
+#define RIL_BINDER_DEFAULT_QUEUE     32
+#define RIL_BINDER_DEFAULT_BUFFER_TRIM (16*1024)
+#define RIL_BINDER_DEFAULT_SIGNAL_DBM_DELTA  2
+#define RIL_BINDER_DEFAULT_SIGNAL_RSRP_DELTA 3
+#define RIL_BINDER_DEFAULT_SIGNAL_RSRQ_DELTA 2
 
 #define DEFAULT_INTERFACE RADIO_INTERFACE_1_2
 
@@ -96,11 +127,14 @@ enum {
     RADIO_EVENT_COUNT
 };
 
+typedef struct ril_binder_radio_encode_ctx RilBinderRadioEncodeCtx;
+
 typedef struct ril_binder_radio_call {
     guint code;
     RADIO_REQ req_tx;
     RADIO_RESP resp_tx;
-    gboolean (*encode)(GRilIoRequest* in, GBinderLocalRequest* out);
+    gboolean (*encode)(GRilIoRequest* in, GBinderLocalRequest* out,
+        RilBinderRadioEncodeCtx* ctx);
     RilBinderRadioDecodeFunc decode;
     const char* name;
 } RilBinderRadioCall;
@@ -112,23 +146,317 @@ typedef struct ril_binder_radio_event {
     const char* name;
 } RilBinderRadioEvent;
 
-typedef struct ril_binder_radio_failure_data {
-    GRilIoTransport* transport;
+/*
+ * Dispatch tables for the negotiated interface version. All versions
+ * up to the negotiated one are merged together (newer entries override
+ * older ones), so each lookup is a single bounds check plus one load.
+ * The tables are immutable, shared by all instances negotiating the
+ * same version and reference counted.
+ */
+typedef struct ril_binder_radio_tables {
+    gint ref_count;
+    RADIO_INTERFACE version;
+    const RilBinderRadioCall** req;     /* RIL code -> call */
+    const RilBinderRadioCall** resp;    /* RADIO_RESP -> call */
+    const RilBinderRadioEvent** unsol;  /* RADIO_IND -> event */
+    guint req_count;
+    guint resp_count;
+    guint unsol_count;
+} RilBinderRadioTables;
+
+typedef struct ril_binder_radio_interface_desc {
+    RADIO_INTERFACE version;
+    const RilBinderRadioCall* calls;
+    guint num_calls;
+    const RilBinderRadioEvent* events;
+    guint num_events;
+} RilBinderRadioInterfaceDesc;
+
+/*
+ * Output buffers are pooled by size class. The class is determined by
+ * the largest payload the buffer has ever held, buffers that exceeded
+ * the trim limit are deallocated rather than returned to the pool.
+ * Decoders ask for the class their output is expected to need (what
+ * the same response or indication needed last time), so that the large
+ * lists which reserve their output up front get a buffer which already
+ * has the room.
+ */
+enum ril_binder_radio_buf_class {
+    RIL_BINDER_BUF_SMALL,
+    RIL_BINDER_BUF_MEDIUM,
+    RIL_BINDER_BUF_LARGE,
+    RIL_BINDER_BUF_CLASS_COUNT
+};
+
+#define RIL_BINDER_BUF_SMALL_SIZE  (256)
+#define RIL_BINDER_BUF_MEDIUM_SIZE (4096)
+#define RIL_BINDER_BUF_PER_CLASS   (2)
+
+typedef struct ril_binder_radio_buf {
+    GByteArray* bytes;
+    guint peak;
+    gsize charged;
+} RilBinderRadioBuf;
+
+/*
+ * Memory owned by the transport. The block is reference counted
+ * because the encoded requests carry a charge against it and release
+ * it when they are deallocated. Only accessed on the main thread.
+ */
+typedef struct ril_binder_radio_mem {
+    gint ref_count;
+    gsize current;
+    gsize peak;
+} RilBinderRadioMem;
+
+/*
+ * Encoder temporaries (strings, HIDL structures and vectors) which have
+ * to stay alive until the request is sent are bump-allocated from the
+ * arena attached to the request. The arena is released with a single
+ * cleanup callback. Default sized chunks are returned to the transport's
+ * free list and reused by subsequent requests, larger ones are freed.
+ */
+typedef struct ril_binder_radio_arena_chunk RilBinderRadioArenaChunk;
+struct ril_binder_radio_arena_chunk {
+    RilBinderRadioArenaChunk* next;
+    gsize size;
+    gsize used;
+    /* Data follows */
+};
+
+typedef struct ril_binder_radio_arena_pool {
+    gint ref_count;
+    RilBinderRadioMem* mem;
+    RilBinderRadioArenaChunk* free;
+    guint free_count;
+} RilBinderRadioArenaPool;
+
+/* Stored in the first chunk of the arena */
+typedef struct ril_binder_radio_arena {
+    RilBinderRadioArenaPool* pool;
+    RilBinderRadioArenaChunk* chunk; /* Current chunk, links to others */
+} RilBinderRadioArena;
+
+/*
+ * Passed to the encoder. Whatever it allocates from the context lives
+ * in the arena, which is attached to the outgoing request once the
+ * encoder returns.
+ */
+struct ril_binder_radio_encode_ctx {
+    RilBinderRadioArenaPool* pool;
+    RilBinderRadioArena* arena;  /* Allocated on demand */
+};
+
+/* Parser for borrowed strings, see ril_binder_radio_parcel_get_str() */
+typedef struct ril_binder_radio_parcel {
+    const guint8* ptr;
+    const guint8* end;
+    RilBinderRadioEncodeCtx* ctx;
+} RilBinderRadioParcel;
+
+#define RIL_BINDER_ARENA_CHUNK_SIZE (1024)
+#define RIL_BINDER_ARENA_FREE_MAX (4)
+#define RIL_BINDER_ARENA_ALIGN(n) (((n) + 7) & ~((gsize)7))
+#define RIL_BINDER_ARENA_HEADER \
+    RIL_BINDER_ARENA_ALIGN(sizeof(RilBinderRadioArenaChunk))
+#define RIL_BINDER_ARENA_DATA(chunk) \
+    (((guint8*)(chunk)) + RIL_BINDER_ARENA_HEADER)
+
+/* Number of int32 values in RIL_UNSOL_SIGNAL_STRENGTH payload */
+#define RIL_SIGNAL_STRENGTH_INTS (14)
+
+/*
+ * Signal strength coalescing. Updates are forwarded immediately only if
+ * the change is significant and the minimum interval has passed since
+ * the last forwarded one. Otherwise the latest state is remembered and
+ * forwarded by the timer (after the rest of the interval for significant
+ * changes, after a quiet period for insignificant ones).
+ */
+typedef struct ril_binder_radio_signal_filter {
+    guint interval;  /* ms, zero disables the filter */
+    int dbm_delta;
+    int rsrp_delta;
+    int rsrq_delta;
+    gint64 last_time;
+    gboolean have_last;
+    gboolean pending;
+    gboolean pending_significant;
+    guint timer_id;
+    gint32 last[RIL_SIGNAL_STRENGTH_INTS];
+    gint32 next[RIL_SIGNAL_STRENGTH_INTS];
+} RilBinderRadioSignalFilter;
+
+/*
+ * Suppression of repeated identical indications. The last delivered
+ * payload is remembered for each of these codes.
+ */
+static const guint ril_binder_radio_dedup_codes[] = {
+    RIL_UNSOL_CELL_INFO_LIST,
+    RIL_UNSOL_DATA_CALL_LIST_CHANGED,
+    RIL_UNSOL_RESPONSE_IMS_NETWORK_STATE_CHANGED
+};
+
+#define RIL_BINDER_DEDUP_COUNT G_N_ELEMENTS(ril_binder_radio_dedup_codes)
+
+typedef struct ril_binder_radio_dedup {
+    GByteArray* last;
+    guint32 hash;
+    gint64 time;
+    guint suppressed;
+} RilBinderRadioDedup;
+
+/*
+ * APN configuration requests which oFono repeats on every SIM and
+ * registration change. The last payload acknowledged by the HAL is
+ * remembered for each of these and identical requests are completed
+ * locally, without disturbing the modem. Disabled unless apnCache is
+ * set, since it relies on the HAL keeping the configuration for as long
+ * as the radio stays on.
+ */
+static const guint ril_binder_radio_apn_cache_codes[] = {
+    RIL_REQUEST_SET_INITIAL_ATTACH_APN,
+    RIL_REQUEST_SET_DATA_PROFILE
+};
+
+#define RIL_BINDER_APN_CACHE_COUNT \
+    G_N_ELEMENTS(ril_binder_radio_apn_cache_codes)
+
+typedef struct ril_binder_radio_apn_cache {
+    GByteArray* acked;      /* NULL if unknown */
+    guint32 acked_hash;
+    GByteArray* sent;       /* Waiting for the response, NULL if none */
+    guint32 sent_hash;
+    guint sent_serial;
+    guint hits;
+} RilBinderRadioApnCache;
+
+/* Requests waiting for ack and/or response, indexed by serial */
+#define RIL_BINDER_PENDING_SIZE (256)
+#define RIL_BINDER_OEM_HOOK_RAW_NAME "oemHookRaw"
+
+typedef struct ril_binder_radio_pending {
+    const char* name;
+    guint serial;
+    gint64 start;
+} RilBinderRadioPending;
+
+/* Indication counters, with 6 x 10 second sliding window */
+#define RIL_BINDER_IND_WINDOW_SLOTS (6)
+#define RIL_BINDER_IND_WINDOW_SLOT_SEC (10)
+
+typedef struct ril_binder_radio_ind_counters {
+    guint count;
+    guint unknown;
+    guint failed;
+    guint64 bytes;
+    guint window[RIL_BINDER_IND_WINDOW_SLOTS];
+    guint epoch[RIL_BINDER_IND_WINDOW_SLOTS];
+} RilBinderRadioIndCounters;
+
+#ifdef RIL_BINDER_PROFILE
+typedef struct ril_binder_radio_profile {
+    const char* name;
+    const char* kind;
+    guint64 calls;
+    guint64 total_ns;
+    guint64 max_ns;
+    guint64 in_bytes;
+    guint64 bytes;
+    guint64 allocs;
+    gulong max_allocs;
+} RilBinderRadioProfile;
+#endif
+
+typedef struct ril_binder_radio_template {
+    GBinderLocalRequest* req;
+    gsize serial_offset;
+} RilBinderRadioTemplate;
+
+typedef struct ril_binder_radio_tx_entry {
+    const RilBinderRadioCall* call;
+    GBinderLocalRequest* txreq;
+    guint serial;
+    gboolean ok;
+} RilBinderRadioTxEntry;
+
+typedef struct ril_binder_radio_tx {
+    RilBinderRadio* self;
+    RadioInstance* radio;
+    guint count;
+    RilBinderRadioTxEntry entry[1];
+} RilBinderRadioTx;
+
+typedef struct ril_binder_radio_batch_entry {
+    const RilBinderRadioCall* call;
+    GRilIoRequest* req;
+} RilBinderRadioBatchEntry;
+
+/* Batch sizes 1, 2, 3-4, 5-8, 9-16, 17-32 and 33+ */
+#define RIL_BINDER_BATCH_HIST_SIZE RIL_BINDER_RADIO_BATCH_BUCKETS
+#define RIL_BINDER_BATCH_LOG_INTERVAL 256
+
+/* Requests completed by the transport itself, waiting to be signaled */
+typedef struct ril_binder_radio_completion {
     guint serial;
-} RilBinderRadioFailureData;
+    guint status;
+} RilBinderRadioCompletion;
+
+typedef struct ril_binder_radio_failures {
+    RilBinderRadioCompletion* entry;
+    guint size;
+    guint first;
+    guint count;
+    gboolean scheduled;
+} RilBinderRadioFailures;
+
+#define RIL_BINDER_FAILURES_INITIAL_SIZE 16
 
 struct ril_binder_radio_priv {
     RilBinderOemHook* oemhook;
     gulong oemhook_raw_response_id;
     GUtilIdleQueue* idle;
-    GByteArray* buf;
+    RilBinderRadioFailures failures;
+    guint buf_trim;
+    guint buf_count[RIL_BINDER_BUF_CLASS_COUNT];
+    RilBinderRadioBuf* buf[RIL_BINDER_BUF_CLASS_COUNT]
+        [RIL_BINDER_BUF_PER_CLASS];
     gulong radio_event_id[RADIO_EVENT_COUNT];
-    /* code -> RilBinderRadioCall */
-    GHashTable* req_map[RADIO_INTERFACE_COUNT];
-    /* resp_tx -> RilBinderRadioCall */
-    GHashTable* resp_map[RADIO_INTERFACE_COUNT];
-    /* unsol_tx -> RilBinderRadioEvent */
-    GHashTable* unsol_map[RADIO_INTERFACE_COUNT];
+    RilBinderRadioTables* tables;
+    /* RIL code -> RilBinderRadioTemplate (allocated on demand) */
+    RilBinderRadioTemplate* templates;
+    /* Asynchronous submission (optional) */
+    GThreadPool* pool;
+    GMainContext* context;
+    guint queue_size;
+    guint queued;
+    /* Batching (optional) */
+    gboolean batch_mode;
+    guint batch_flush_id;
+    RilBinderRadioBatchEntry* batch;
+    guint batch_count;
+    guint batch_alloc;
+    guint batch_flushes;
+    guint batch_hist[RIL_BINDER_BATCH_HIST_SIZE];
+    RilBinderRadioSignalFilter signal;
+    guint dedup_window; /* ms, zero disables deduplication */
+    RilBinderRadioDedup dedup[RIL_BINDER_DEDUP_COUNT];
+    gboolean apn_cache; /* FALSE forces pass-through */
+    RilBinderRadioApnCache apn[RIL_BINDER_APN_CACHE_COUNT];
+    RilBinderRadioPending pending[RIL_BINDER_PENDING_SIZE];
+    /* name -> RilBinderRadioLatency */
+    GHashTable* latency;
+    /* RADIO_IND -> counters, the last one is for unexpected codes */
+    RilBinderRadioIndCounters* ind;
+    RilBinderRadioIndCounters* ind_current;
+    RADIO_RESP resp_current;
+    /* RADIO_RESP -> buffer class of the last decoded response */
+    guint8* resp_buf_class;
+    RilBinderRecorder* recorder;
+    RilBinderRadioMem* mem;
+    RilBinderRadioArenaPool* arena;
+#ifdef RIL_BINDER_PROFILE
+    RilBinderRadioProfile* prof_decode;
+#endif
 };
 
 G_DEFINE_TYPE(RilBinderRadio, ril_binder_radio, GRILIO_TYPE_TRANSPORT)
@@ -136,6 +464,16 @@ G_DEFINE_TYPE(RilBinderRadio, ril_binder_radio, GRILIO_TYPE_TRANSPORT)
 #define PARENT_CLASS ril_binder_radio_parent_class
 
 #define ARRAY_AND_COUNT(a) a, G_N_ELEMENTS(a)
+#define ALIGN4(n) (((n) + 3) & ~3)
+
+/* Sizes of the RIL cell info records produced by the decoders */
+#define RIL_INT32_SIZE                 (4)
+#define RIL_CELL_INFO_HEADER_SIZE      (5 * RIL_INT32_SIZE)
+#define RIL_CELL_INFO_GSM_SIZE         (9 * RIL_INT32_SIZE)
+#define RIL_CELL_INFO_CDMA_SIZE        (10 * RIL_INT32_SIZE)
+#define RIL_CELL_INFO_LTE_SIZE         (12 * RIL_INT32_SIZE)
+#define RIL_CELL_INFO_WCDMA_SIZE       (8 * RIL_INT32_SIZE)
+#define RIL_CELL_INFO_TDSCDMA_SIZE     (6 * RIL_INT32_SIZE)
 #define DBG_(self,fmt,args...) \
     GDEBUG("%s" fmt, (self)->parent.log_prefix, ##args)
 
@@ -143,160 +481,493 @@ G_DEFINE_TYPE(RilBinderRadio, ril_binder_radio, GRILIO_TYPE_TRANSPORT)
  * Utilities
  *==========================================================================*/
 
-#define ril_binder_radio_write_hidl_string_data(writer,ptr,field,index) \
-    ril_binder_radio_write_hidl_string_data2(writer,ptr,field,index,0)
-#define ril_binder_radio_write_hidl_string_data2(writer,ptr,field,index,off) \
-     ril_binder_radio_write_string_with_parent(writer, &ptr->field, index, \
-        (off) + ((guint8*)(&ptr->field) - (guint8*)ptr))
+static
+RilBinderRadioMem*
+ril_binder_radio_mem_new(
+    void)
+{
+    RilBinderRadioMem* mem = g_slice_new0(RilBinderRadioMem);
+
+    mem->ref_count = 1;
+    return mem;
+}
 
 static
-inline
 void
-ril_binder_radio_write_string_with_parent(
-    GBinderWriter* writer,
-    const GBinderHidlString* str,
-    guint32 index,
-    guint32 offset)
+ril_binder_radio_mem_unref(
+    RilBinderRadioMem* mem)
 {
-    GBinderParent parent;
-
-    parent.index = index;
-    parent.offset = offset;
+    if (!(--mem->ref_count)) {
+        g_slice_free(RilBinderRadioMem, mem);
+    }
+}
 
-    /* Strings are NULL-terminated, hence len + 1 */
-    gbinder_writer_append_buffer_object_with_parent(writer, str->data.str,
-        str->len + 1, &parent);
+static
+void
+ril_binder_radio_mem_charge(
+    RilBinderRadioMem* mem,
+    gsize size)
+{
+    mem->current += size;
+    if (mem->peak < mem->current) {
+        mem->peak = mem->current;
+    }
 }
 
 static
 void
-ril_binder_radio_write_data_profile_strings(
-    GBinderWriter* w,
-    const RadioDataProfile* dp,
-    guint idx,
-    guint i)
+ril_binder_radio_mem_uncharge(
+    RilBinderRadioMem* mem,
+    gsize size)
+{
+    GASSERT(mem->current >= size);
+    mem->current -= size;
+}
+
+static
+RilBinderRadioArenaPool*
+ril_binder_radio_arena_pool_new(
+    RilBinderRadioMem* mem)
 {
-    const guint off = sizeof(*dp) * i;
+    RilBinderRadioArenaPool* pool = g_slice_new0(RilBinderRadioArenaPool);
 
-    /* Write the string data in the right order */
-    ril_binder_radio_write_hidl_string_data2(w, dp, apn, idx, off);
-    ril_binder_radio_write_hidl_string_data2(w, dp, protocol, idx, off);
-    ril_binder_radio_write_hidl_string_data2(w, dp, roamingProtocol, idx, off);
-    ril_binder_radio_write_hidl_string_data2(w, dp, user, idx, off);
-    ril_binder_radio_write_hidl_string_data2(w, dp, password, idx, off);
-    ril_binder_radio_write_hidl_string_data2(w, dp, mvnoMatchData, idx, off);
+    pool->ref_count = 1;
+    pool->mem = mem;
+    mem->ref_count++;
+    return pool;
 }
 
-inline
 static
 void
-ril_binder_radio_write_single_data_profile(
-    GBinderWriter* writer,
-    const RadioDataProfile* dp)
+ril_binder_radio_arena_pool_unref(
+    RilBinderRadioArenaPool* pool)
 {
-    ril_binder_radio_write_data_profile_strings(writer, dp,
-        gbinder_writer_append_buffer_object(writer, dp, sizeof(*dp)), 0);
+    if (!(--pool->ref_count)) {
+        while (pool->free) {
+            RilBinderRadioArenaChunk* chunk = pool->free;
+
+            pool->free = chunk->next;
+            ril_binder_radio_mem_uncharge(pool->mem,
+                RIL_BINDER_ARENA_HEADER + chunk->size);
+            g_free(chunk);
+        }
+        ril_binder_radio_mem_unref(pool->mem);
+        g_slice_free(RilBinderRadioArenaPool, pool);
+    }
 }
 
 static
-void
-ril_binder_radio_take_string(
-    GBinderLocalRequest* out,
-    GBinderHidlString* str,
-    char* chars)
+RilBinderRadioArenaChunk*
+ril_binder_radio_arena_chunk_new(
+    RilBinderRadioArenaPool* pool,
+    gsize size)
 {
-    str->owns_buffer = TRUE;
-    if (chars && chars[0]) {
-        /* GBinderLocalRequest takes ownership of the string contents */
-        str->data.str = chars;
-        str->len = strlen(chars);
-        gbinder_local_request_cleanup(out, g_free, chars);
+    RilBinderRadioArenaChunk* chunk;
+
+    if (size <= RIL_BINDER_ARENA_CHUNK_SIZE && pool->free) {
+        chunk = pool->free;
+        pool->free = chunk->next;
+        pool->free_count--;
     } else {
-        /* Replace NULL strings with empty strings */
-        str->data.str = "";
-        str->len = 0;
-        g_free(chars);
+        size = MAX(size, RIL_BINDER_ARENA_CHUNK_SIZE);
+        chunk = g_malloc(RIL_BINDER_ARENA_HEADER + size);
+        chunk->size = size;
+        ril_binder_radio_mem_charge(pool->mem, RIL_BINDER_ARENA_HEADER +
+            size);
     }
+    chunk->next = NULL;
+    chunk->used = 0;
+    return chunk;
 }
 
 static
 void
-ril_binder_radio_init_parser(
-    GRilIoParser* parser,
-    GRilIoRequest* r)
+ril_binder_radio_arena_free(
+    gpointer data)
 {
-    grilio_parser_init(parser, grilio_request_data(r), grilio_request_size(r));
+    RilBinderRadioArena* arena = data;
+    RilBinderRadioArenaPool* pool = arena->pool;
+    RilBinderRadioArenaChunk* chunk = arena->chunk;
+
+    /* The arena itself lives in the last chunk, don't touch it anymore */
+    while (chunk) {
+        RilBinderRadioArenaChunk* next = chunk->next;
+
+        if (chunk->size == RIL_BINDER_ARENA_CHUNK_SIZE &&
+            pool->free_count < RIL_BINDER_ARENA_FREE_MAX) {
+            chunk->next = pool->free;
+            pool->free = chunk;
+            pool->free_count++;
+        } else {
+            ril_binder_radio_mem_uncharge(pool->mem,
+                RIL_BINDER_ARENA_HEADER + chunk->size);
+            g_free(chunk);
+        }
+        chunk = next;
+    }
+    ril_binder_radio_arena_pool_unref(pool);
 }
 
 static
-const char*
-ril_binder_radio_arg_value(
-    GHashTable* args,
-    const char* key,
-    const char* def)
+gpointer
+ril_binder_radio_encode_alloc(
+    RilBinderRadioEncodeCtx* ctx,
+    gsize size)
 {
-    const char* val = args ? g_hash_table_lookup(args, key) : NULL;
+    RilBinderRadioArena* arena = ctx->arena;
+    RilBinderRadioArenaChunk* chunk;
+    gpointer ptr;
 
-    return (val && val[0]) ? val : def;
+    size = RIL_BINDER_ARENA_ALIGN(size);
+    if (G_UNLIKELY(!arena)) {
+        const gsize header = RIL_BINDER_ARENA_ALIGN(sizeof(*arena));
+
+        /* The first allocation creates the arena, one per request */
+        chunk = ril_binder_radio_arena_chunk_new(ctx->pool, header + size);
+        arena = (RilBinderRadioArena*)RIL_BINDER_ARENA_DATA(chunk);
+        arena->pool = ctx->pool;
+        arena->chunk = chunk;
+        arena->pool->ref_count++;
+        chunk->used = header;
+        ctx->arena = arena;
+    } else {
+        chunk = arena->chunk;
+        if (G_UNLIKELY(chunk->used + size > chunk->size)) {
+            chunk = ril_binder_radio_arena_chunk_new(arena->pool, size);
+            chunk->next = arena->chunk;
+            arena->chunk = chunk;
+        }
+    }
+
+    ptr = RIL_BINDER_ARENA_DATA(chunk) + chunk->used;
+    chunk->used += size;
+    return ptr;
+}
+
+static
+gpointer
+ril_binder_radio_encode_alloc0(
+    RilBinderRadioEncodeCtx* ctx,
+    gsize size)
+{
+    return memset(ril_binder_radio_encode_alloc(ctx, size), 0, size);
 }
 
+#define ril_binder_radio_encode_new0(ctx,type) \
+    ((type*)ril_binder_radio_encode_alloc0(ctx, sizeof(type)))
+
 static
 void
-ril_binder_radio_init_call_maps(
-    GHashTable* req_map,
-    GHashTable* resp_map,
-    const RilBinderRadioCall* calls,
-    guint count)
+ril_binder_radio_parcel_init(
+    RilBinderRadioParcel* parcel,
+    GRilIoRequest* in,
+    RilBinderRadioEncodeCtx* ctx)
 {
-    guint i;
+    parcel->ptr = grilio_request_data(in);
+    parcel->end = parcel->ptr + grilio_request_size(in);
+    parcel->ctx = ctx;
+}
 
-    for (i = 0; i < count; i++) {
-        const RilBinderRadioCall* call = calls + i;
+static
+gboolean
+ril_binder_radio_parcel_get_int32(
+    RilBinderRadioParcel* parcel,
+    gint32* value)
+{
+    if (parcel->ptr + 4 <= parcel->end) {
+        if (value) {
+            memcpy(value, parcel->ptr, 4);
+        }
+        parcel->ptr += 4;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static
+gboolean
+ril_binder_radio_parcel_get_uint32(
+    RilBinderRadioParcel* parcel,
+    guint32* value)
+{
+    return ril_binder_radio_parcel_get_int32(parcel, (gint32*)value);
+}
+
+/*
+ * Converts RIL string (int32 length, UTF-16 units and the terminator,
+ * padded to 4 bytes) to UTF-8 placed into the encoder's arena.
+ * The string remains valid until the request is sent. NULL strings are
+ * returned as NULL, invalid ones fail like grilio_parser_get_utf8().
+ */
+static
+gboolean
+ril_binder_radio_parcel_get_nullable_str(
+    RilBinderRadioParcel* parcel,
+    const char** str)
+{
+    const guint8* ptr = parcel->ptr;
+    gint32 len;
 
-        if (call->req_tx) {
-            g_hash_table_insert(req_map, GINT_TO_POINTER(call->code),
-                (gpointer) call);
+    if (ptr + 4 > parcel->end) {
+        return FALSE;
+    }
+    memcpy(&len, ptr, 4);
+    ptr += 4;
+    if (len < 0) {
+        parcel->ptr = ptr;
+        *str = NULL;
+        return TRUE;
+    } else if ((gsize)len < (gsize)(parcel->end - ptr) / 2) {
+        /* Checked without arithmetic on len, which may be G_MAXINT32 */
+        const guint16* utf16 = (const guint16*)ptr;
+        char* utf8 = ril_binder_radio_encode_alloc(parcel->ctx,
+            ((gsize)len) * 3 + 1);
+        char* out = utf8;
+        gint32 i;
+
+        for (i = 0; i < len; i++) {
+            guint32 c = utf16[i];
+
+            if (c >= 0xd800 && c < 0xdc00) {
+                /* High surrogate, must be followed by a low one */
+                if (i + 1 < len && utf16[i + 1] >= 0xdc00 &&
+                    utf16[i + 1] < 0xe000) {
+                    c = 0x10000 + ((c - 0xd800) << 10) +
+                        (utf16[++i] - 0xdc00);
+                } else {
+                    return FALSE;
+                }
+            } else if (c >= 0xdc00 && c < 0xe000) {
+                return FALSE;
+            }
+            out += g_unichar_to_utf8(c, out);
         }
-        if (call->resp_tx) {
-            g_hash_table_insert(resp_map, GINT_TO_POINTER(call->resp_tx),
-                (gpointer) call);
+        *out = 0;
+        parcel->ptr = ptr + ALIGN4(((gsize)len + 1) * 2);
+        if (parcel->ptr > parcel->end) {
+            parcel->ptr = parcel->end;
         }
+        *str = utf8;
+        return TRUE;
     }
+    return FALSE;
+}
+
+static
+const char*
+ril_binder_radio_parcel_get_str(
+    RilBinderRadioParcel* parcel)
+{
+    const char* str;
+
+    return ril_binder_radio_parcel_get_nullable_str(parcel, &str) ?
+        str : NULL;
 }
 
+/*
+ * Layout of a HIDL structure: its size and offsets of the string fields
+ * in the order in which their contents follows the structure. These are
+ * compile-time constants derived from the radio_types.h definitions, and
+ * RIL_BINDER_HIDL_STRING() refuses to compile unless the field actually
+ * is a hidl_string. The number of strings is derived from the argument
+ * list of RIL_BINDER_LAYOUT().
+ */
+#define RIL_BINDER_LAYOUT_MAX_STRINGS (6)
+typedef struct ril_binder_radio_layout {
+    guint size;
+    guint count;
+    guint offset[RIL_BINDER_LAYOUT_MAX_STRINGS];
+} RilBinderRadioLayout;
+
+#define RIL_BINDER_HIDL_STRING(type,field) (G_STRUCT_OFFSET(type,field) + \
+    0 * sizeof(char[__builtin_types_compatible_p( \
+    __typeof__(((type*)0)->field), GBinderHidlString) ? 1 : -1]))
+#define RIL_BINDER_LAYOUT_COUNT(strings...) \
+    (sizeof((guint[]){ strings }) / sizeof(guint))
+#define RIL_BINDER_LAYOUT(type,strings...) \
+    { sizeof(type), RIL_BINDER_LAYOUT_COUNT(strings) + \
+    0 * sizeof(char[(RIL_BINDER_LAYOUT_COUNT(strings) <= \
+    RIL_BINDER_LAYOUT_MAX_STRINGS) ? 1 : -1]), { strings } }
+
+static const RilBinderRadioLayout ril_binder_radio_layout_dial =
+    RIL_BINDER_LAYOUT(RadioDial,
+        RIL_BINDER_HIDL_STRING(RadioDial, address));
+static const RilBinderRadioLayout ril_binder_radio_layout_gsm_sms =
+    RIL_BINDER_LAYOUT(RadioGsmSmsMessage,
+        RIL_BINDER_HIDL_STRING(RadioGsmSmsMessage, smscPdu),
+        RIL_BINDER_HIDL_STRING(RadioGsmSmsMessage, pdu));
+static const RilBinderRadioLayout ril_binder_radio_layout_sms_write_args =
+    RIL_BINDER_LAYOUT(RadioSmsWriteArgs,
+        RIL_BINDER_HIDL_STRING(RadioSmsWriteArgs, pdu),
+        RIL_BINDER_HIDL_STRING(RadioSmsWriteArgs, smsc));
+static const RilBinderRadioLayout ril_binder_radio_layout_icc_io =
+    RIL_BINDER_LAYOUT(RadioIccIo,
+        RIL_BINDER_HIDL_STRING(RadioIccIo, path),
+        RIL_BINDER_HIDL_STRING(RadioIccIo, data),
+        RIL_BINDER_HIDL_STRING(RadioIccIo, pin2),
+        RIL_BINDER_HIDL_STRING(RadioIccIo, aid));
+static const RilBinderRadioLayout ril_binder_radio_layout_call_forward =
+    RIL_BINDER_LAYOUT(RadioCallForwardInfo,
+        RIL_BINDER_HIDL_STRING(RadioCallForwardInfo, number));
+static const RilBinderRadioLayout ril_binder_radio_layout_data_profile =
+    RIL_BINDER_LAYOUT(RadioDataProfile,
+        RIL_BINDER_HIDL_STRING(RadioDataProfile, apn),
+        RIL_BINDER_HIDL_STRING(RadioDataProfile, protocol),
+        RIL_BINDER_HIDL_STRING(RadioDataProfile, roamingProtocol),
+        RIL_BINDER_HIDL_STRING(RadioDataProfile, user),
+        RIL_BINDER_HIDL_STRING(RadioDataProfile, password),
+        RIL_BINDER_HIDL_STRING(RadioDataProfile, mvnoMatchData));
+static const RilBinderRadioLayout ril_binder_radio_layout_capability =
+    RIL_BINDER_LAYOUT(RadioCapability,
+        RIL_BINDER_HIDL_STRING(RadioCapability, logicalModemUuid));
+static const RilBinderRadioLayout ril_binder_radio_layout_sim_apdu =
+    RIL_BINDER_LAYOUT(RadioSimApdu,
+        RIL_BINDER_HIDL_STRING(RadioSimApdu, data));
+
+/* Writes string contents of the element located at offset in buffer */
 static
 void
-ril_binder_radio_init_unsol_map(
-    GHashTable* unsol_map,
-    const RilBinderRadioEvent* events,
-    guint count)
+ril_binder_radio_write_strings(
+    GBinderWriter* writer,
+    const RilBinderRadioLayout* layout,
+    const void* elem,
+    guint32 index,
+    guint32 offset)
+{
+    GBinderParent parent;
+    guint i;
+
+    parent.index = index;
+    for (i = 0; i < layout->count; i++) {
+        const GBinderHidlString* str = (const GBinderHidlString*)
+            ((const guint8*)elem + layout->offset[i]);
+
+        /* Strings are NULL-terminated, hence len + 1 */
+        parent.offset = offset + layout->offset[i];
+        gbinder_writer_append_buffer_object_with_parent(writer,
+            str->data.str, str->len + 1, &parent);
+    }
+}
+
+/* Writes the structure followed by its strings, returns buffer index */
+static
+guint
+ril_binder_radio_write_struct(
+    GBinderWriter* writer,
+    const RilBinderRadioLayout* layout,
+    const void* data)
+{
+    const guint index = gbinder_writer_append_buffer_object(writer,
+        data, layout->size);
+
+    ril_binder_radio_write_strings(writer, layout, data, index, 0);
+    return index;
+}
+
+/* Same for an array of structures, e.g. the contents of hidl_vec */
+static
+guint
+ril_binder_radio_write_struct_array(
+    GBinderWriter* writer,
+    const RilBinderRadioLayout* layout,
+    const void* data,
+    guint n,
+    const GBinderParent* parent)
 {
+    const guint index = gbinder_writer_append_buffer_object_with_parent
+        (writer, data, layout->size * n, parent);
     guint i;
 
-    for (i = 0; i < count; i++) {
-        const RilBinderRadioEvent* event = events + i;
+    for (i = 0; i < n; i++) {
+        ril_binder_radio_write_strings(writer, layout,
+            (const guint8*)data + layout->size * i, index,
+            layout->size * i);
+    }
+    return index;
+}
+
+static
+void
+ril_binder_radio_borrow_string(
+    GBinderHidlString* str,
+    const char* chars)
+{
+    /* The contents stays alive until the request is sent */
+    str->owns_buffer = TRUE;
+    if (chars && chars[0]) {
+        str->data.str = chars;
+        str->len = strlen(chars);
+    } else {
+        str->data.str = "";
+        str->len = 0;
+    }
+}
+
+/*
+ * Returns the number of bytes grilio_encode_utf8() is going to append
+ * to the buffer. It's exact for valid UTF-8 and never underestimates.
+ */
+static
+gsize
+ril_binder_radio_utf8_size(
+    const char* str)
+{
+    if (str) {
+        const guint8* ptr = (const guint8*)str;
+        gsize units = 0;
+
+        while (*ptr) {
+            const guint8 c = *ptr++;
 
-        g_hash_table_insert(unsol_map, GINT_TO_POINTER(event->unsol_tx),
-            (gpointer) event);
+            if ((c & 0xc0) != 0x80) {
+                /* Characters outside of BMP take two UTF-16 units */
+                units += (c >= 0xf0) ? 2 : 1;
+            }
+        }
+        /* Length, UTF-16 units with NULL terminator, padding */
+        return RIL_INT32_SIZE + ALIGN4((units + 1) * 2);
+    } else {
+        /* Length only (-1) */
+        return RIL_INT32_SIZE;
     }
 }
 
+/*
+ * Makes sure that at least extra bytes can be appended to the buffer
+ * without reallocating it. GByteArray never shrinks its allocation when
+ * the size is reduced.
+ */
+static
+void
+ril_binder_radio_reserve(
+    GByteArray* buf,
+    gsize extra)
+{
+    const guint len = buf->len;
+
+    g_byte_array_set_size(buf, len + extra);
+    g_byte_array_set_size(buf, len);
+}
+
 static
 void
-ril_binder_radio_init_version(
-    RilBinderRadioPriv* priv,
-    RADIO_INTERFACE v,
-    const RilBinderRadioCall* calls,
-    guint num_calls,
-    const RilBinderRadioEvent* events,
-    guint num_events)
+ril_binder_radio_init_parser(
+    GRilIoParser* parser,
+    GRilIoRequest* r)
+{
+    grilio_parser_init(parser, grilio_request_data(r), grilio_request_size(r));
+}
+
+static
+const char*
+ril_binder_radio_arg_value(
+    GHashTable* args,
+    const char* key,
+    const char* def)
 {
-    priv->req_map[v] = g_hash_table_new(g_direct_hash, g_direct_equal);
-    priv->resp_map[v] = g_hash_table_new(g_direct_hash, g_direct_equal);
-    priv->unsol_map[v] = g_hash_table_new(g_direct_hash, g_direct_equal);
-    ril_binder_radio_init_unsol_map(priv->unsol_map[v], events, num_events);
-    ril_binder_radio_init_call_maps(priv->req_map[v], priv->resp_map[v],
-        calls, num_calls);
+    const char* val = args ? g_hash_table_lookup(args, key) : NULL;
+
+    return (val && val[0]) ? val : def;
 }
 
 static
@@ -360,223 +1031,254 @@ ril_binder_radio_interface_name(
 }
 
 /*==========================================================================*
- * Encoders (plugin -> binder)
+ * Schemas
+ *
+ * Calls which simply convert a sequence of scalars and strings between
+ * the RIL and HIDL representations are described by a short string of
+ * opcodes run by a common interpreter, rather than having a dedicated
+ * encoder or decoder each. The named functions referenced by dispatch
+ * tables are one-line thunks generated by the macros below.
  *==========================================================================*/
 
-static
-gboolean
-ril_binder_radio_encode_serial(
-    GRilIoRequest* in,
-    GBinderLocalRequest* out)
-{
-    gbinder_local_request_append_int32(out, grilio_request_serial(in));
-    return TRUE;
-}
+typedef enum ril_binder_radio_op {
+    RIL_BINDER_OP_END,
+    RIL_BINDER_OP_COUNT,    /* RIL element count, the next byte is value */
+    RIL_BINDER_OP_INT,      /* int32 */
+    RIL_BINDER_OP_INT_OPT,  /* int32, zero if missing (encoder only) */
+    RIL_BINDER_OP_BOOL,     /* int32 on RIL side, bool on HIDL side */
+    RIL_BINDER_OP_DEC_INT,  /* Decimal string to int32 (encoder only) */
+    RIL_BINDER_OP_DEC_BOOL, /* Decimal string to bool (encoder only) */
+    RIL_BINDER_OP_STR,      /* Non-NULL string */
+    RIL_BINDER_OP_NSTR,     /* NULL is sent as empty (encoder only) */
+    RIL_BINDER_OP_INTS,     /* Counted int32 array */
+    RIL_BINDER_OP_STRS,     /* Counted nullable strings (encoder only) */
+    RIL_BINDER_OP_BYTES     /* Raw byte vector (decoder only) */
+} RIL_BINDER_OP;
 
+/*
+ * The serial is always written first. Everything else is written as
+ * soon as it's parsed, the request is dropped if encoding fails.
+ */
 static
 gboolean
-ril_binder_radio_encode_int(
+ril_binder_radio_encode_schema(
+    const guint8* op,
     GRilIoRequest* in,
-    GBinderLocalRequest* out)
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
 {
-    GRilIoParser parser;
+    RilBinderRadioParcel parcel;
+    GBinderWriter writer;
+    const char* str;
     gint32 value;
-
-    ril_binder_radio_init_parser(&parser, in);
-    if (grilio_parser_get_int32(&parser, &value)) {
-        GBinderWriter writer;
-
-        gbinder_local_request_init_writer(out, &writer);
-        gbinder_writer_append_int32(&writer, grilio_request_serial(in));
-        gbinder_writer_append_int32(&writer, value);
-        return TRUE;
-    }
-    return FALSE;
-}
-
-static
-gboolean
-ril_binder_radio_encode_bool(
-    GRilIoRequest* in,
-    GBinderLocalRequest* out)
-{
-    GRilIoParser parser;
-    gint32 count, value;
-
-    ril_binder_radio_init_parser(&parser, in);
-    if (grilio_parser_get_int32(&parser, &count) && count == 1 &&
-        grilio_parser_get_int32(&parser, &value)) {
-        GBinderWriter writer;
-
-        gbinder_local_request_init_writer(out, &writer);
-        gbinder_writer_append_int32(&writer, grilio_request_serial(in));
-        gbinder_writer_append_bool(&writer, value);
-        return TRUE;
+    guint32 i, n;
+
+    ril_binder_radio_parcel_init(&parcel, in, ctx);
+    gbinder_local_request_init_writer(out, &writer);
+    gbinder_writer_append_int32(&writer, grilio_request_serial(in));
+    for (;;) {
+        switch ((RIL_BINDER_OP)*op++) {
+        case RIL_BINDER_OP_END:
+            return TRUE;
+        case RIL_BINDER_OP_COUNT:
+            if (!ril_binder_radio_parcel_get_int32(&parcel, &value) ||
+                value != *op++) {
+                return FALSE;
+            }
+            break;
+        case RIL_BINDER_OP_INT:
+            if (!ril_binder_radio_parcel_get_int32(&parcel, &value)) {
+                return FALSE;
+            }
+            gbinder_writer_append_int32(&writer, value);
+            break;
+        case RIL_BINDER_OP_INT_OPT:
+            value = 0;
+            ril_binder_radio_parcel_get_int32(&parcel, &value);
+            gbinder_writer_append_int32(&writer, value);
+            break;
+        case RIL_BINDER_OP_BOOL:
+            if (!ril_binder_radio_parcel_get_int32(&parcel, &value)) {
+                return FALSE;
+            }
+            gbinder_writer_append_bool(&writer, value);
+            break;
+        case RIL_BINDER_OP_DEC_INT:
+            if (!gutil_parse_int(ril_binder_radio_parcel_get_str(&parcel),
+                10, &value)) {
+                return FALSE;
+            }
+            gbinder_writer_append_int32(&writer, value);
+            break;
+        case RIL_BINDER_OP_DEC_BOOL:
+            if (!gutil_parse_int(ril_binder_radio_parcel_get_str(&parcel),
+                10, &value)) {
+                return FALSE;
+            }
+            gbinder_writer_append_bool(&writer, value);
+            break;
+        case RIL_BINDER_OP_STR:
+            if (!(str = ril_binder_radio_parcel_get_str(&parcel))) {
+                return FALSE;
+            }
+            gbinder_writer_append_hidl_string(&writer, str);
+            break;
+        case RIL_BINDER_OP_NSTR:
+            if (!ril_binder_radio_parcel_get_nullable_str(&parcel, &str)) {
+                return FALSE;
+            }
+            gbinder_writer_append_hidl_string(&writer, str ? str : "");
+            break;
+        case RIL_BINDER_OP_INTS:
+            if (!ril_binder_radio_parcel_get_uint32(&parcel, &n)) {
+                return FALSE;
+            }
+            for (i = 0; i < n; i++) {
+                if (!ril_binder_radio_parcel_get_int32(&parcel, &value)) {
+                    return FALSE;
+                }
+                gbinder_writer_append_int32(&writer, value);
+            }
+            break;
+        case RIL_BINDER_OP_STRS:
+            if (!ril_binder_radio_parcel_get_uint32(&parcel, &n)) {
+                return FALSE;
+            }
+            for (i = 0; i < n; i++) {
+                if (!ril_binder_radio_parcel_get_nullable_str(&parcel,
+                    &str)) {
+                    return FALSE;
+                }
+                gbinder_writer_append_hidl_string(&writer, str ? str : "");
+            }
+            break;
+        default:
+            GASSERT(FALSE);
+            return FALSE;
+        }
     }
-    return FALSE;
 }
 
 static
 gboolean
-ril_binder_radio_encode_ints(
-    GRilIoRequest* in,
-    GBinderLocalRequest* out)
+ril_binder_radio_decode_schema(
+    const guint8* op,
+    GBinderReader* in,
+    GByteArray* out)
 {
-    GRilIoParser parser;
-    gint32 count;
-
-    ril_binder_radio_init_parser(&parser, in);
-    if (grilio_parser_get_int32(&parser, &count)) {
-        GBinderWriter writer;
-        guint i;
-
-        gbinder_local_request_init_writer(out, &writer);
-        gbinder_writer_append_int32(&writer, grilio_request_serial(in));
-        for (i = 0; i < count; i++) {
-            gint32 value;
+    const char* str;
+    const void* ptr;
+    gint32 value;
+    gsize i, n;
 
-            if (grilio_parser_get_int32(&parser, &value)) {
-                gbinder_writer_append_int32(&writer, value);
-            } else {
+    for (;;) {
+        switch ((RIL_BINDER_OP)*op++) {
+        case RIL_BINDER_OP_END:
+            return TRUE;
+        case RIL_BINDER_OP_COUNT:
+            grilio_encode_int32(out, *op++);
+            break;
+        case RIL_BINDER_OP_INT:
+            if (!gbinder_reader_read_int32(in, &value)) {
+                return FALSE;
+            }
+            grilio_encode_int32(out, value);
+            break;
+        case RIL_BINDER_OP_BOOL:
+            if (!gbinder_reader_read_bool(in, &value)) {
+                return FALSE;
+            }
+            grilio_encode_int32(out, value);
+            break;
+        case RIL_BINDER_OP_STR:
+            if (!(str = gbinder_reader_read_hidl_string_c(in))) {
+                return FALSE;
+            }
+            grilio_encode_utf8(out, str);
+            break;
+        case RIL_BINDER_OP_INTS:
+            if (!(ptr = gbinder_reader_read_hidl_type_vec(in, gint32, &n))) {
+                return FALSE;
+            }
+            grilio_encode_int32(out, n);
+            for (i = 0; i < n; i++) {
+                grilio_encode_int32(out, ((const gint32*)ptr)[i]);
+            }
+            break;
+        case RIL_BINDER_OP_BYTES:
+            if (!(ptr = gbinder_reader_read_hidl_byte_vec(in, &n))) {
                 return FALSE;
             }
+            g_byte_array_append(out, ptr, n);
+            break;
+        default:
+            GASSERT(FALSE);
+            return FALSE;
         }
-        return TRUE;
     }
-    return FALSE;
 }
 
-static
-gboolean
-ril_binder_radio_encode_string(
-    GRilIoRequest* in,
-    GBinderLocalRequest* out)
-{
-    GRilIoParser parser;
-    char* str;
+#define RIL_BINDER_SCHEMA_ENCODER(name,ops...) \
+    static gboolean ril_binder_radio_encode_##name(GRilIoRequest* in, \
+        GBinderLocalRequest* out, RilBinderRadioEncodeCtx* ctx) { \
+        static const guint8 schema[] = { ops, RIL_BINDER_OP_END }; \
+        return ril_binder_radio_encode_schema(schema, in, out, ctx); }
+#define RIL_BINDER_SCHEMA_DECODER(name,ops...) \
+    static gboolean ril_binder_radio_decode_##name(GBinderReader* in, \
+        GByteArray* out) { static const guint8 schema[] = { \
+        ops, RIL_BINDER_OP_END }; \
+        return ril_binder_radio_decode_schema(schema, in, out); }
 
-    ril_binder_radio_init_parser(&parser, in);
-    str = grilio_parser_get_utf8(&parser);
-    if (str) {
-        GBinderWriter writer;
+#define OP_(op) RIL_BINDER_OP_##op
+#define COUNT_(n) RIL_BINDER_OP_COUNT, n
 
-        gbinder_local_request_cleanup(out, g_free, str);
-        gbinder_local_request_init_writer(out, &writer);
-        gbinder_writer_append_int32(&writer, grilio_request_serial(in));
-        gbinder_writer_append_hidl_string(&writer, str);
-        return TRUE;
-    }
-    return FALSE;
-}
+/*==========================================================================*
+ * Encoders (plugin -> binder)
+ *==========================================================================*/
 
 static
 gboolean
-ril_binder_radio_encode_strings(
+ril_binder_radio_encode_serial(
     GRilIoRequest* in,
-    GBinderLocalRequest* out)
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
 {
-    GRilIoParser parser;
-    gint32 count;
-
-    ril_binder_radio_init_parser(&parser, in);
-    if (grilio_parser_get_int32(&parser, &count)) {
-        GBinderWriter writer;
-        guint i;
-
-        gbinder_local_request_init_writer(out, &writer);
-        gbinder_writer_append_int32(&writer, grilio_request_serial(in));
-        for (i = 0; i < count; i++) {
-            char* str;
-
-            if (grilio_parser_get_nullable_utf8(&parser, &str)) {
-                if (str) {
-                    gbinder_local_request_cleanup(out, g_free, str);
-                    gbinder_writer_append_hidl_string(&writer, str);
-                } else {
-                    gbinder_writer_append_hidl_string(&writer, "");
-                }
-            } else {
-                return FALSE;
-            }
-        }
-        return TRUE;
-    }
-    return FALSE;
+    gbinder_local_request_append_int32(out, grilio_request_serial(in));
+    return TRUE;
 }
 
-static
-gboolean
-ril_binder_radio_encode_ints_to_bool_int(
-    GRilIoRequest* in,
-    GBinderLocalRequest* out)
-{
-    GRilIoParser parser;
-    gint32 count, arg1, arg2;
+RIL_BINDER_SCHEMA_ENCODER(int, OP_(INT))
 
-    ril_binder_radio_init_parser(&parser, in);
-    if (grilio_parser_get_int32(&parser, &count) && count == 2 &&
-        grilio_parser_get_int32(&parser, &arg1) &&
-        grilio_parser_get_int32(&parser, &arg2)) {
-        GBinderWriter writer;
+RIL_BINDER_SCHEMA_ENCODER(bool, COUNT_(1), OP_(BOOL))
 
-        gbinder_local_request_init_writer(out, &writer);
-        gbinder_writer_append_int32(&writer, grilio_request_serial(in));
-        gbinder_writer_append_bool(&writer, arg1);
-        gbinder_writer_append_int32(&writer, arg2);
-        return TRUE;
-    }
-    return FALSE;
-}
+RIL_BINDER_SCHEMA_ENCODER(ints, OP_(INTS))
 
-static
-gboolean
-ril_binder_radio_encode_deactivate_data_call(
-    GRilIoRequest* in,
-    GBinderLocalRequest* out)
-{
-    gboolean ok = FALSE;
-    GRilIoParser parser;
-    gint32 count, cid, reason;
-    char* cid_str = NULL;
-    char* reason_str = NULL;
+RIL_BINDER_SCHEMA_ENCODER(string, OP_(STR))
 
-    ril_binder_radio_init_parser(&parser, in);
-    if (grilio_parser_get_int32(&parser, &count) && count == 2 &&
-        (cid_str = grilio_parser_get_utf8(&parser)) != NULL &&
-        (reason_str = grilio_parser_get_utf8(&parser)) != NULL &&
-        gutil_parse_int(cid_str, 10, &cid) &&
-        gutil_parse_int(reason_str, 10, &reason)) {
-        GBinderWriter writer;
+RIL_BINDER_SCHEMA_ENCODER(strings, OP_(STRS))
 
-        gbinder_local_request_init_writer(out, &writer);
-        gbinder_writer_append_int32(&writer, grilio_request_serial(in));
-        gbinder_writer_append_int32(&writer, cid);
-        gbinder_writer_append_bool(&writer, reason);
-        ok = TRUE;
-    }
-    g_free(cid_str);
-    g_free(reason_str);
-    return ok;
-}
+RIL_BINDER_SCHEMA_ENCODER(ints_to_bool_int, COUNT_(2), OP_(BOOL),
+    OP_(INT))
+
+RIL_BINDER_SCHEMA_ENCODER(deactivate_data_call, COUNT_(2), OP_(DEC_INT),
+    OP_(DEC_BOOL))
 
 static
 gboolean
 ril_binder_radio_encode_deactivate_data_call_1_2(
     GRilIoRequest* in,
-    GBinderLocalRequest* out)
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
 {
-    gboolean ok = FALSE;
-    GRilIoParser parser;
+    RilBinderRadioParcel parcel;
     gint32 count, cid, reason;
-    char* cid_str = NULL;
-    char* reason_str = NULL;
 
-    ril_binder_radio_init_parser(&parser, in);
-    if (grilio_parser_get_int32(&parser, &count) && count == 2 &&
-        (cid_str = grilio_parser_get_utf8(&parser)) != NULL &&
-        (reason_str = grilio_parser_get_utf8(&parser)) != NULL &&
-        gutil_parse_int(cid_str, 10, &cid) &&
-        gutil_parse_int(reason_str, 10, &reason)) {
+    ril_binder_radio_parcel_init(&parcel, in, ctx);
+    if (ril_binder_radio_parcel_get_int32(&parcel, &count) && count == 2 &&
+        gutil_parse_int(ril_binder_radio_parcel_get_str(&parcel), 10,
+            &cid) &&
+        gutil_parse_int(ril_binder_radio_parcel_get_str(&parcel), 10,
+            &reason)) {
         GBinderWriter writer;
 
         if (reason == 0) {
@@ -591,11 +1293,9 @@ ril_binder_radio_encode_deactivate_data_call_1_2(
         gbinder_writer_append_int32(&writer, grilio_request_serial(in));
         gbinder_writer_append_int32(&writer, cid);
         gbinder_writer_append_int32(&writer, reason);
-        ok = TRUE;
+        return TRUE;
     }
-    g_free(cid_str);
-    g_free(reason_str);
-    return ok;
+    return FALSE;
 }
 
 /**
@@ -606,15 +1306,16 @@ static
 gboolean
 ril_binder_radio_encode_dial(
     GRilIoRequest* in,
-    GBinderLocalRequest* out)
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
 {
-    GRilIoParser parser;
-    char* number;
+    RilBinderRadioParcel parcel;
+    const char* number;
     gint32 clir;
 
-    ril_binder_radio_init_parser(&parser, in);
-    if ((number = grilio_parser_get_utf8(&parser)) != NULL &&
-        grilio_parser_get_int32(&parser, &clir)) {
+    ril_binder_radio_parcel_init(&parcel, in, ctx);
+    if ((number = ril_binder_radio_parcel_get_str(&parcel)) != NULL &&
+        ril_binder_radio_parcel_get_int32(&parcel, &clir)) {
         /* and ignore UUS information */
         GBinderWriter writer;
         GBinderParent parent;
@@ -622,20 +1323,16 @@ ril_binder_radio_encode_dial(
 
         /* Initialize the writer and the data to be written */
         gbinder_local_request_init_writer(out, &writer);
-        dial = gbinder_writer_new0(&writer, RadioDial);
-        ril_binder_radio_take_string(out, &dial->address, number);
+        dial = ril_binder_radio_encode_new0(ctx, RadioDial);
+        ril_binder_radio_borrow_string(&dial->address, number);
         dial->clir = clir;
 
         /* Write the arguments */
         gbinder_writer_append_int32(&writer, grilio_request_serial(in));
 
-        /* Write the parent structure */
-        parent.index = gbinder_writer_append_buffer_object(&writer, dial,
-            sizeof(*dial));
-
-        /* Write the string data */
-        ril_binder_radio_write_hidl_string_data(&writer, dial, address,
-            parent.index);
+        /* Write the structure and the string data */
+        parent.index = ril_binder_radio_write_struct(&writer,
+            &ril_binder_radio_layout_dial, dial);
 
         /* UUS information is empty but we still need to write a buffer */
         parent.offset = G_STRUCT_OFFSET(RadioDial, uusInfo.data.ptr);
@@ -654,42 +1351,35 @@ static
 gboolean
 ril_binder_radio_encode_gsm_sms_message(
     GRilIoRequest* in,
-    GBinderLocalRequest* out)
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
 {
-    GRilIoParser parser;
+    RilBinderRadioParcel parcel;
     gint32 count;
-    char* smsc = NULL;
-    char* pdu = NULL;
+    const char* smsc;
+    const char* pdu;
 
-    ril_binder_radio_init_parser(&parser, in);
-    if (grilio_parser_get_int32(&parser, &count) && count == 2 &&
-        grilio_parser_get_nullable_utf8(&parser, &smsc) &&
-        (pdu = grilio_parser_get_utf8(&parser)) != NULL) {
+    ril_binder_radio_parcel_init(&parcel, in, ctx);
+    if (ril_binder_radio_parcel_get_int32(&parcel, &count) && count == 2 &&
+        ril_binder_radio_parcel_get_nullable_str(&parcel, &smsc) &&
+        (pdu = ril_binder_radio_parcel_get_str(&parcel)) != NULL) {
         RadioGsmSmsMessage* sms;
         GBinderWriter writer;
-        guint parent;
 
         /* Initialize the writer and the data to be written */
         gbinder_local_request_init_writer(out, &writer);
-        sms = gbinder_writer_new0(&writer, RadioGsmSmsMessage);
-        ril_binder_radio_take_string(out, &sms->smscPdu, smsc);
-        ril_binder_radio_take_string(out, &sms->pdu, pdu);
+        sms = ril_binder_radio_encode_new0(ctx, RadioGsmSmsMessage);
+        ril_binder_radio_borrow_string(&sms->smscPdu, smsc);
+        ril_binder_radio_borrow_string(&sms->pdu, pdu);
 
         /* Write the arguments */
         gbinder_writer_append_int32(&writer, grilio_request_serial(in));
 
-        /* Write the parent structure */
-        parent = gbinder_writer_append_buffer_object(&writer,
-            sms, sizeof(*sms));
-
-        /* Write the string data in the right order */
-        ril_binder_radio_write_hidl_string_data(&writer, sms, smscPdu, parent);
-        ril_binder_radio_write_hidl_string_data(&writer, sms, pdu, parent);
+        /* Write the structure and the string data */
+        ril_binder_radio_write_struct(&writer,
+            &ril_binder_radio_layout_gsm_sms, sms);
         return TRUE;
     }
-
-    g_free(smsc);
-    g_free(pdu);
     return FALSE;
 }
 
@@ -706,31 +1396,28 @@ static
 gboolean
 ril_binder_radio_encode_setup_data_call(
     GRilIoRequest* in,
-    GBinderLocalRequest* out)
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
 {
-    gboolean ok = FALSE;
-    GRilIoParser parser;
+    RilBinderRadioParcel parcel;
     gint32 count, tech, auth, profile_id;
-    char* profile_str = NULL;
-    char* tech_str = NULL;
-    char* apn = NULL;
-    char* user = NULL;
-    char* password = NULL;
-    char* auth_str = NULL;
-    char* proto = NULL;
-
-    ril_binder_radio_init_parser(&parser, in);
-    if (grilio_parser_get_int32(&parser, &count) && count == 7 &&
-        (tech_str = grilio_parser_get_utf8(&parser)) != NULL &&
-        gutil_parse_int(tech_str, 10, &tech) &&
-        (profile_str = grilio_parser_get_utf8(&parser)) != NULL &&
-        gutil_parse_int(profile_str, 10, &profile_id) &&
-        (apn = grilio_parser_get_utf8(&parser)) != NULL &&
-        (user = grilio_parser_get_utf8(&parser)) != NULL &&
-        (password = grilio_parser_get_utf8(&parser)) != NULL &&
-        (auth_str = grilio_parser_get_utf8(&parser)) != NULL &&
-        gutil_parse_int(auth_str, 10, &auth) &&
-        (proto = grilio_parser_get_utf8(&parser)) != NULL) {
+    const char* apn;
+    const char* user;
+    const char* password;
+    const char* proto;
+
+    ril_binder_radio_parcel_init(&parcel, in, ctx);
+    if (ril_binder_radio_parcel_get_int32(&parcel, &count) && count == 7 &&
+        gutil_parse_int(ril_binder_radio_parcel_get_str(&parcel), 10,
+            &tech) &&
+        gutil_parse_int(ril_binder_radio_parcel_get_str(&parcel), 10,
+            &profile_id) &&
+        (apn = ril_binder_radio_parcel_get_str(&parcel)) != NULL &&
+        (user = ril_binder_radio_parcel_get_str(&parcel)) != NULL &&
+        (password = ril_binder_radio_parcel_get_str(&parcel)) != NULL &&
+        gutil_parse_int(ril_binder_radio_parcel_get_str(&parcel), 10,
+            &auth) &&
+        (proto = ril_binder_radio_parcel_get_str(&parcel)) != NULL) {
         GBinderWriter writer;
         RadioDataProfile* profile;
 
@@ -748,12 +1435,12 @@ ril_binder_radio_encode_setup_data_call(
 
         /* Initialize the writer and the data to be written */
         gbinder_local_request_init_writer(out, &writer);
-        profile = gbinder_writer_new0(&writer, RadioDataProfile);
-        ril_binder_radio_take_string(out, &profile->apn, apn);
-        ril_binder_radio_take_string(out, &profile->protocol, proto);
-        ril_binder_radio_take_string(out, &profile->user, user);
-        ril_binder_radio_take_string(out, &profile->password, password);
-        ril_binder_radio_take_string(out, &profile->mvnoMatchData, NULL);
+        profile = ril_binder_radio_encode_new0(ctx, RadioDataProfile);
+        ril_binder_radio_borrow_string(&profile->apn, apn);
+        ril_binder_radio_borrow_string(&profile->protocol, proto);
+        ril_binder_radio_borrow_string(&profile->user, user);
+        ril_binder_radio_borrow_string(&profile->password, password);
+        ril_binder_radio_borrow_string(&profile->mvnoMatchData, NULL);
         profile->roamingProtocol = profile->protocol;
         profile->profileId = profile_id;
         profile->authType = auth;
@@ -764,23 +1451,15 @@ ril_binder_radio_encode_setup_data_call(
         /* Write the parcel */
         gbinder_writer_append_int32(&writer, grilio_request_serial(in));
         gbinder_writer_append_int32(&writer, tech); /* radioTechnology */
-        ril_binder_radio_write_single_data_profile(&writer, profile);
+        ril_binder_radio_write_struct(&writer,
+            &ril_binder_radio_layout_data_profile, profile);
         gbinder_writer_append_bool(&writer, FALSE); /* modemCognitive */
         /* TODO: provide the actual roaming status? */
         gbinder_writer_append_bool(&writer, TRUE);  /* roamingAllowed */
         gbinder_writer_append_bool(&writer, FALSE); /* isRoaming */
-        ok = TRUE;
-    } else {
-        g_free(apn);
-        g_free(user);
-        g_free(password);
-        g_free(proto);
+        return TRUE;
     }
-
-    g_free(profile_str);
-    g_free(tech_str);
-    g_free(auth_str);
-    return ok;
+    return FALSE;
 }
 
 /**
@@ -796,31 +1475,28 @@ static
 gboolean
 ril_binder_radio_encode_setup_data_call_1_2(
     GRilIoRequest* in,
-    GBinderLocalRequest* out)
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
 {
-    gboolean ok = FALSE;
-    GRilIoParser parser;
+    RilBinderRadioParcel parcel;
     gint32 count, tech, auth, profile_id;
-    char* profile_str = NULL;
-    char* tech_str = NULL;
-    char* auth_str = NULL;
-    char* apn = NULL;
-    char* user = NULL;
-    char* password = NULL;
-    char* proto = NULL;
-
-    ril_binder_radio_init_parser(&parser, in);
-    if (grilio_parser_get_int32(&parser, &count) && count == 7 &&
-        (tech_str = grilio_parser_get_utf8(&parser)) != NULL &&
-        gutil_parse_int(tech_str, 10, &tech) &&
-        (profile_str = grilio_parser_get_utf8(&parser)) != NULL &&
-        gutil_parse_int(profile_str, 10, &profile_id) &&
-        (apn = grilio_parser_get_utf8(&parser)) != NULL &&
-        (user = grilio_parser_get_utf8(&parser)) != NULL &&
-        (password = grilio_parser_get_utf8(&parser)) != NULL &&
-        (auth_str = grilio_parser_get_utf8(&parser)) != NULL &&
-        gutil_parse_int(auth_str, 10, &auth) &&
-        (proto = grilio_parser_get_utf8(&parser)) != NULL) {
+    const char* apn;
+    const char* user;
+    const char* password;
+    const char* proto;
+
+    ril_binder_radio_parcel_init(&parcel, in, ctx);
+    if (ril_binder_radio_parcel_get_int32(&parcel, &count) && count == 7 &&
+        gutil_parse_int(ril_binder_radio_parcel_get_str(&parcel), 10,
+            &tech) &&
+        gutil_parse_int(ril_binder_radio_parcel_get_str(&parcel), 10,
+            &profile_id) &&
+        (apn = ril_binder_radio_parcel_get_str(&parcel)) != NULL &&
+        (user = ril_binder_radio_parcel_get_str(&parcel)) != NULL &&
+        (password = ril_binder_radio_parcel_get_str(&parcel)) != NULL &&
+        gutil_parse_int(ril_binder_radio_parcel_get_str(&parcel), 10,
+            &auth) &&
+        (proto = ril_binder_radio_parcel_get_str(&parcel)) != NULL) {
         GBinderWriter writer;
         RadioDataProfile* profile;
         RADIO_ACCESS_NETWORK ran;
@@ -874,12 +1550,12 @@ ril_binder_radio_encode_setup_data_call_1_2(
 
         /* Initialize the writer and the data to be written */
         gbinder_local_request_init_writer(out, &writer);
-        profile = gbinder_writer_new0(&writer, RadioDataProfile);
-        ril_binder_radio_take_string(out, &profile->apn, apn);
-        ril_binder_radio_take_string(out, &profile->protocol, proto);
-        ril_binder_radio_take_string(out, &profile->user, user);
-        ril_binder_radio_take_string(out, &profile->password, password);
-        ril_binder_radio_take_string(out, &profile->mvnoMatchData, NULL);
+        profile = ril_binder_radio_encode_new0(ctx, RadioDataProfile);
+        ril_binder_radio_borrow_string(&profile->apn, apn);
+        ril_binder_radio_borrow_string(&profile->protocol, proto);
+        ril_binder_radio_borrow_string(&profile->user, user);
+        ril_binder_radio_borrow_string(&profile->password, password);
+        ril_binder_radio_borrow_string(&profile->mvnoMatchData, NULL);
         profile->roamingProtocol = profile->protocol;
         profile->profileId = profile_id;
         profile->authType = auth;
@@ -890,7 +1566,8 @@ ril_binder_radio_encode_setup_data_call_1_2(
         /* Write the parcel */
         gbinder_writer_append_int32(&writer, grilio_request_serial(in));
         gbinder_writer_append_int32(&writer, ran); /* accessNetwork */
-        ril_binder_radio_write_single_data_profile(&writer, profile);
+        ril_binder_radio_write_struct(&writer,
+            &ril_binder_radio_layout_data_profile, profile);
         gbinder_writer_append_bool(&writer, FALSE); /* modemCognitive */
         /* TODO: provide the actual roaming status? */
         gbinder_writer_append_bool(&writer, TRUE);  /* roamingAllowed */
@@ -898,18 +1575,9 @@ ril_binder_radio_encode_setup_data_call_1_2(
         gbinder_writer_append_int32(&writer, RADIO_DATA_REQUEST_REASON_NORMAL);
         gbinder_writer_append_hidl_string_vec(&writer, NULL, 0); /* addresses */
         gbinder_writer_append_hidl_string_vec(&writer, NULL, 0); /* dnses */
-        ok = TRUE;
-    } else {
-        g_free(apn);
-        g_free(user);
-        g_free(password);
-        g_free(proto);
+        return TRUE;
     }
-
-    g_free(profile_str);
-    g_free(tech_str);
-    g_free(auth_str);
-    return ok;
+    return FALSE;
 }
 
 /**
@@ -920,42 +1588,34 @@ static
 gboolean
 ril_binder_radio_encode_sms_write_args(
     GRilIoRequest* in,
-    GBinderLocalRequest* out)
-{
-    RadioSmsWriteArgs* sms = g_new0(RadioSmsWriteArgs, 1);
-    GRilIoParser parser;
-    char* pdu = NULL;
-    char* smsc = NULL;
-
-    ril_binder_radio_init_parser(&parser, in);
-    if (grilio_parser_get_int32(&parser, &sms->status) &&
-        (pdu = grilio_parser_get_utf8(&parser)) != NULL &&
-        grilio_parser_get_nullable_utf8(&parser, &smsc)) {
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
+{
+    RadioSmsWriteArgs* sms =
+        ril_binder_radio_encode_new0(ctx, RadioSmsWriteArgs);
+    RilBinderRadioParcel parcel;
+    const char* pdu;
+    const char* smsc;
+
+    ril_binder_radio_parcel_init(&parcel, in, ctx);
+    if (ril_binder_radio_parcel_get_int32(&parcel, &sms->status) &&
+        (pdu = ril_binder_radio_parcel_get_str(&parcel)) != NULL &&
+        ril_binder_radio_parcel_get_nullable_str(&parcel, &smsc)) {
         GBinderWriter writer;
-        guint parent;
 
         /* Initialize the writer and the data to be written */
         gbinder_local_request_init_writer(out, &writer);
-        gbinder_local_request_cleanup(out, g_free, sms);
-        ril_binder_radio_take_string(out, &sms->pdu, pdu);
-        ril_binder_radio_take_string(out, &sms->smsc, smsc);
+        ril_binder_radio_borrow_string(&sms->pdu, pdu);
+        ril_binder_radio_borrow_string(&sms->smsc, smsc);
 
         /* Write the arguments */
         gbinder_writer_append_int32(&writer, grilio_request_serial(in));
 
-        /* Write the parent structure */
-        parent = gbinder_writer_append_buffer_object(&writer,
-            sms, sizeof(*sms));
-
-        /* Write the string data in the right order */
-        ril_binder_radio_write_hidl_string_data(&writer, sms, pdu, parent);
-        ril_binder_radio_write_hidl_string_data(&writer, sms, smsc, parent);
+        /* Write the structure and the string data */
+        ril_binder_radio_write_struct(&writer,
+            &ril_binder_radio_layout_sms_write_args, sms);
         return TRUE;
     }
-
-    g_free(smsc);
-    g_free(pdu);
-    g_free(sms);
     return FALSE;
 }
 
@@ -967,55 +1627,43 @@ static
 gboolean
 ril_binder_radio_encode_icc_io(
     GRilIoRequest* in,
-    GBinderLocalRequest* out)
-{
-    GRilIoParser parser;
-    RadioIccIo* io = g_new0(RadioIccIo, 1);
-    char* path = NULL;
-    char* data = NULL;
-    char* pin2 = NULL;
-    char* aid = NULL;
-
-    ril_binder_radio_init_parser(&parser, in);
-    if (grilio_parser_get_int32(&parser, &io->command) &&
-        grilio_parser_get_int32(&parser, &io->fileId) &&
-        grilio_parser_get_nullable_utf8(&parser, &path) &&
-        grilio_parser_get_int32(&parser, &io->p1) &&
-        grilio_parser_get_int32(&parser, &io->p2) &&
-        grilio_parser_get_int32(&parser, &io->p3) &&
-        grilio_parser_get_nullable_utf8(&parser, &data) &&
-        grilio_parser_get_nullable_utf8(&parser, &pin2) &&
-        grilio_parser_get_nullable_utf8(&parser, &aid)) {
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
+{
+    RilBinderRadioParcel parcel;
+    RadioIccIo* io = ril_binder_radio_encode_new0(ctx, RadioIccIo);
+    const char* path;
+    const char* data;
+    const char* pin2;
+    const char* aid;
+
+    ril_binder_radio_parcel_init(&parcel, in, ctx);
+    if (ril_binder_radio_parcel_get_int32(&parcel, &io->command) &&
+        ril_binder_radio_parcel_get_int32(&parcel, &io->fileId) &&
+        ril_binder_radio_parcel_get_nullable_str(&parcel, &path) &&
+        ril_binder_radio_parcel_get_int32(&parcel, &io->p1) &&
+        ril_binder_radio_parcel_get_int32(&parcel, &io->p2) &&
+        ril_binder_radio_parcel_get_int32(&parcel, &io->p3) &&
+        ril_binder_radio_parcel_get_nullable_str(&parcel, &data) &&
+        ril_binder_radio_parcel_get_nullable_str(&parcel, &pin2) &&
+        ril_binder_radio_parcel_get_nullable_str(&parcel, &aid)) {
         GBinderWriter writer;
-        guint parent;
 
         /* Initialize the writer and the data to be written */
         gbinder_local_request_init_writer(out, &writer);
-        gbinder_local_request_cleanup(out, g_free, io);
-        ril_binder_radio_take_string(out, &io->path, path);
-        ril_binder_radio_take_string(out, &io->data, data);
-        ril_binder_radio_take_string(out, &io->pin2, pin2);
-        ril_binder_radio_take_string(out, &io->aid, aid);
+        ril_binder_radio_borrow_string(&io->path, path);
+        ril_binder_radio_borrow_string(&io->data, data);
+        ril_binder_radio_borrow_string(&io->pin2, pin2);
+        ril_binder_radio_borrow_string(&io->aid, aid);
 
         /* Write the arguments */
         gbinder_writer_append_int32(&writer, grilio_request_serial(in));
 
-        /* Write the parent structure */
-        parent = gbinder_writer_append_buffer_object(&writer, io, sizeof(*io));
-
-        /* Write the string data in the right order */
-        ril_binder_radio_write_hidl_string_data(&writer, io, path, parent);
-        ril_binder_radio_write_hidl_string_data(&writer, io, data, parent);
-        ril_binder_radio_write_hidl_string_data(&writer, io, pin2, parent);
-        ril_binder_radio_write_hidl_string_data(&writer, io, aid, parent);
+        /* Write the structure and the string data */
+        ril_binder_radio_write_struct(&writer,
+            &ril_binder_radio_layout_icc_io, io);
         return TRUE;
     }
-
-    g_free(io);
-    g_free(path);
-    g_free(data);
-    g_free(pin2);
-    g_free(aid);
     return FALSE;
 }
 
@@ -1027,43 +1675,37 @@ static
 gboolean
 ril_binder_radio_encode_call_forward_info(
     GRilIoRequest* in,
-    GBinderLocalRequest* out)
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
 {
-    GRilIoParser parser;
-    RadioCallForwardInfo* info = g_new0(RadioCallForwardInfo, 1);
-    char* number = NULL;
+    RilBinderRadioParcel parcel;
+    RadioCallForwardInfo* info =
+        ril_binder_radio_encode_new0(ctx, RadioCallForwardInfo);
+    const char* number;
     gint32 status = 0;
 
-    ril_binder_radio_init_parser(&parser, in);
-    if (grilio_parser_get_int32(&parser, &status) &&
-        grilio_parser_get_int32(&parser, &info->reason) &&
-        grilio_parser_get_int32(&parser, &info->serviceClass) &&
-        grilio_parser_get_int32(&parser, &info->toa) &&
-        grilio_parser_get_nullable_utf8(&parser, &number) &&
-        grilio_parser_get_int32(&parser, &info->timeSeconds)) {
+    ril_binder_radio_parcel_init(&parcel, in, ctx);
+    if (ril_binder_radio_parcel_get_int32(&parcel, &status) &&
+        ril_binder_radio_parcel_get_int32(&parcel, &info->reason) &&
+        ril_binder_radio_parcel_get_int32(&parcel, &info->serviceClass) &&
+        ril_binder_radio_parcel_get_int32(&parcel, &info->toa) &&
+        ril_binder_radio_parcel_get_nullable_str(&parcel, &number) &&
+        ril_binder_radio_parcel_get_int32(&parcel, &info->timeSeconds)) {
         GBinderWriter writer;
-        guint parent;
 
         /* Initialize the writer and the data to be written */
         gbinder_local_request_init_writer(out, &writer);
-        gbinder_local_request_cleanup(out, g_free, info);
-        ril_binder_radio_take_string(out, &info->number, number);
+        ril_binder_radio_borrow_string(&info->number, number);
 
         /* Write the arguments */
         gbinder_writer_append_int32(&writer, grilio_request_serial(in));
 
-        /* Write the parent structure */
+        /* Write the structure and the string data */
         info->status = status;
-        parent = gbinder_writer_append_buffer_object(&writer,
-            info, sizeof(*info));
-
-        /* Write the string data */
-        ril_binder_radio_write_hidl_string_data(&writer, info, number, parent);
+        ril_binder_radio_write_struct(&writer,
+            &ril_binder_radio_layout_call_forward, info);
         return TRUE;
     }
-
-    g_free(info);
-    g_free(number);
     return FALSE;
 }
 
@@ -1074,140 +1716,19 @@ ril_binder_radio_encode_call_forward_info(
  * @param serviceClass is the TS 27.007 service class bit vector of services
  * @param appId is AID value, empty string if no value.
  */
-static
-gboolean
-ril_binder_radio_encode_get_facility_lock(
-    GRilIoRequest* in,
-    GBinderLocalRequest* out)
-{
-    gboolean ok = FALSE;
-    GRilIoParser parser;
-    gint32 count;
-    char* fac = NULL;
-    char* pwd = NULL;
-    char* cls = NULL;
-    char* aid = NULL;
-    int cls_num;
-
-    ril_binder_radio_init_parser(&parser, in);
-    if (grilio_parser_get_int32(&parser, &count) && count == 4 &&
-        grilio_parser_get_nullable_utf8(&parser, &fac) &&
-        grilio_parser_get_nullable_utf8(&parser, &pwd) &&
-        grilio_parser_get_nullable_utf8(&parser, &cls) &&
-        grilio_parser_get_nullable_utf8(&parser, &aid) &&
-        gutil_parse_int(cls, 10, &cls_num)) {
-        GBinderWriter writer;
+RIL_BINDER_SCHEMA_ENCODER(get_facility_lock, COUNT_(4), OP_(NSTR),
+    OP_(NSTR), OP_(DEC_INT), OP_(NSTR))
 
-        gbinder_local_request_init_writer(out, &writer);
-        gbinder_writer_append_int32(&writer, grilio_request_serial(in));
-
-        if (fac) {
-            gbinder_local_request_cleanup(out, g_free, fac);
-            gbinder_writer_append_hidl_string(&writer, fac);
-        } else {
-            gbinder_writer_append_hidl_string(&writer, "");
-        }
-
-        if (pwd) {
-            gbinder_local_request_cleanup(out, g_free, pwd);
-            gbinder_writer_append_hidl_string(&writer, pwd);
-        } else {
-            gbinder_writer_append_hidl_string(&writer, "");
-        }
-
-        gbinder_writer_append_int32(&writer, cls_num);
-
-        if (aid) {
-            gbinder_local_request_cleanup(out, g_free, aid);
-            gbinder_writer_append_hidl_string(&writer, aid);
-        } else {
-            gbinder_writer_append_hidl_string(&writer, "");
-        }
-
-        ok = TRUE;
-    } else {
-        g_free(fac);
-        g_free(pwd);
-        g_free(aid);
-    }
-
-    g_free(cls);
-    return ok;
-}
-
-/**
- * @param int32_t Serial number of request.
- * @param facility is the facility string code from TS 27.007 7.4
- * @param lockState false for "unlock" and true for "lock"
- * @param password is the password
- * @param serviceClass is string representation of decimal TS 27.007
- * @param appId is AID value, empty string if no value.
- */
-static
-gboolean
-ril_binder_radio_encode_set_facility_lock(
-    GRilIoRequest* in,
-    GBinderLocalRequest* out)
-{
-    gboolean ok = FALSE;
-    GRilIoParser parser;
-    char* fac = NULL;
-    char* lock = NULL;
-    char* pwd = NULL;
-    char* cls = NULL;
-    char* aid = NULL;
-    gint32 count, lock_num, cls_num;
-
-    ril_binder_radio_init_parser(&parser, in);
-    if (grilio_parser_get_int32(&parser, &count) && count == 5 &&
-        grilio_parser_get_nullable_utf8(&parser, &fac) &&
-        grilio_parser_get_nullable_utf8(&parser, &lock) &&
-        grilio_parser_get_nullable_utf8(&parser, &pwd) &&
-        grilio_parser_get_nullable_utf8(&parser, &cls) &&
-        grilio_parser_get_nullable_utf8(&parser, &aid) &&
-        gutil_parse_int(lock, 10, &lock_num) &&
-        gutil_parse_int(cls, 10, &cls_num)) {
-        GBinderWriter writer;
-
-        gbinder_local_request_init_writer(out, &writer);
-        gbinder_writer_append_int32(&writer, grilio_request_serial(in));
-
-        if (fac) {
-            gbinder_local_request_cleanup(out, g_free, fac);
-            gbinder_writer_append_hidl_string(&writer, fac);
-        } else {
-            gbinder_writer_append_hidl_string(&writer, "");
-        }
-
-        gbinder_writer_append_bool(&writer, lock_num);
-
-        if (pwd) {
-            gbinder_local_request_cleanup(out, g_free, pwd);
-            gbinder_writer_append_hidl_string(&writer, pwd);
-        } else {
-            gbinder_writer_append_hidl_string(&writer, "");
-        }
-
-        gbinder_writer_append_int32(&writer, cls_num);
-
-        if (aid) {
-            gbinder_local_request_cleanup(out, g_free, aid);
-            gbinder_writer_append_hidl_string(&writer, aid);
-        } else {
-            gbinder_writer_append_hidl_string(&writer, "");
-        }
-
-        ok = TRUE;
-    } else {
-        g_free(fac);
-        g_free(pwd);
-        g_free(aid);
-    }
-
-    g_free(lock);
-    g_free(cls);
-    return ok;
-}
+/**
+ * @param int32_t Serial number of request.
+ * @param facility is the facility string code from TS 27.007 7.4
+ * @param lockState false for "unlock" and true for "lock"
+ * @param password is the password
+ * @param serviceClass is string representation of decimal TS 27.007
+ * @param appId is AID value, empty string if no value.
+ */
+RIL_BINDER_SCHEMA_ENCODER(set_facility_lock, COUNT_(5), OP_(NSTR),
+    OP_(DEC_BOOL), OP_(NSTR), OP_(DEC_INT), OP_(NSTR))
 
 /**
  * @param int32_t Serial number of request.
@@ -1234,7 +1755,8 @@ static
 gboolean
 ril_binder_radio_map_screen_state_to_device_state(
     GRilIoRequest* in,
-    GBinderLocalRequest* out)
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
 {
     GRilIoParser parser;
     gint32 count, value;
@@ -1249,25 +1771,7 @@ ril_binder_radio_map_screen_state_to_device_state(
     return FALSE;
 }
 
-static
-gboolean
-ril_binder_radio_encode_device_state(
-    GRilIoRequest* in,
-    GBinderLocalRequest* out)
-{
-    GRilIoParser parser;
-    gint32 count, type, state;
-
-    ril_binder_radio_init_parser(&parser, in);
-    if (grilio_parser_get_int32(&parser, &count) && count == 2 &&
-        grilio_parser_get_int32(&parser, &type) &&
-        grilio_parser_get_int32(&parser, &state)) {
-        ril_binder_radio_device_state_req(out, grilio_request_serial(in),
-            type, state);
-        return TRUE;
-    }
-    return FALSE;
-}
+RIL_BINDER_SCHEMA_ENCODER(device_state, COUNT_(2), OP_(INT), OP_(BOOL))
 
 /**
  * @param int32_t Serial number of request.
@@ -1277,43 +1781,47 @@ static
 gboolean
 ril_binder_radio_encode_gsm_broadcast_sms_config(
     GRilIoRequest* in,
-    GBinderLocalRequest* out)
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
 {
-    GRilIoParser parser;
-    gint32 count;
+    RilBinderRadioParcel parcel;
+    guint32 count;
 
-    ril_binder_radio_init_parser(&parser, in);
-    if (grilio_parser_get_int32(&parser, &count)) {
-        GBinderHidlVec* vec = g_new0(GBinderHidlVec, 1);
+    /* Each config takes 5 ints, don't allocate more than that */
+    ril_binder_radio_parcel_init(&parcel, in, ctx);
+    if (ril_binder_radio_parcel_get_uint32(&parcel, &count) &&
+        count <= (gsize)(parcel.end - parcel.ptr) / (5 * RIL_INT32_SIZE)) {
+        GBinderHidlVec* vec =
+            ril_binder_radio_encode_new0(ctx, GBinderHidlVec);
         RadioGsmBroadcastSmsConfig* configs = NULL;
         gboolean ok = TRUE;
         guint i;
 
         vec->count = count;
         vec->owns_buffer = TRUE;
-        gbinder_local_request_cleanup(out, g_free, vec);
         if (count > 0) {
-            configs = g_new0(RadioGsmBroadcastSmsConfig, count);
-            gbinder_local_request_cleanup(out, g_free, configs);
+            configs = ril_binder_radio_encode_alloc0(ctx, sizeof(*configs) *
+                count);
             vec->data.ptr = configs;
         }
 
         for (i = 0; i < count && ok; i++) {
-            RadioGsmBroadcastSmsConfig* config = configs + i;
+            RadioGsmBroadcastSmsConfig* cfg = configs + i;
+            RilBinderRadioParcel* p = &parcel;
             gint32 selected;
 
-            if (grilio_parser_get_int32(&parser, &config->fromServiceId) &&
-                grilio_parser_get_int32(&parser, &config->toServiceId) &&
-                grilio_parser_get_int32(&parser, &config->fromCodeScheme) &&
-                grilio_parser_get_int32(&parser, &config->toCodeScheme) &&
-                grilio_parser_get_int32(&parser, &selected)) {
-                config->selected = (guint8)selected;
+            if (ril_binder_radio_parcel_get_int32(p, &cfg->fromServiceId) &&
+                ril_binder_radio_parcel_get_int32(p, &cfg->toServiceId) &&
+                ril_binder_radio_parcel_get_int32(p, &cfg->fromCodeScheme) &&
+                ril_binder_radio_parcel_get_int32(p, &cfg->toCodeScheme) &&
+                ril_binder_radio_parcel_get_int32(p, &selected)) {
+                cfg->selected = (guint8)selected;
             } else {
                 ok = FALSE;
             }
         }
 
-        if (ok && grilio_parser_at_end(&parser)) {
+        if (ok && parcel.ptr == parcel.end) {
             GBinderWriter writer;
             GBinderParent parent;
 
@@ -1344,19 +1852,20 @@ static
 gboolean
 ril_binder_radio_encode_uicc_sub(
     GRilIoRequest* in,
-    GBinderLocalRequest* out)
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
 {
-    GRilIoParser parser;
-    RadioSelectUiccSub* sub = g_new0(RadioSelectUiccSub, 1);
+    RilBinderRadioParcel parcel;
+    RadioSelectUiccSub* sub =
+        ril_binder_radio_encode_new0(ctx, RadioSelectUiccSub);
     gint32 status = 0;
 
-    gbinder_local_request_cleanup(out, g_free, sub);
-    ril_binder_radio_init_parser(&parser, in);
-    if (grilio_parser_get_int32(&parser, &sub->slot) &&
-        grilio_parser_get_int32(&parser, &sub->appIndex) &&
-        grilio_parser_get_int32(&parser, &sub->subType) &&
-        grilio_parser_get_int32(&parser, &status) &&
-        grilio_parser_at_end(&parser)) {
+    ril_binder_radio_parcel_init(&parcel, in, ctx);
+    if (ril_binder_radio_parcel_get_int32(&parcel, &sub->slot) &&
+        ril_binder_radio_parcel_get_int32(&parcel, &sub->appIndex) &&
+        ril_binder_radio_parcel_get_int32(&parcel, &sub->subType) &&
+        ril_binder_radio_parcel_get_int32(&parcel, &status) &&
+        parcel.ptr == parcel.end) {
         GBinderWriter writer;
 
         sub->actStatus = status;
@@ -1379,32 +1888,33 @@ static
 gboolean
 ril_binder_radio_encode_initial_attach_apn(
     GRilIoRequest* in,
-    GBinderLocalRequest* out)
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
 {
-    GRilIoParser parser;
-    char* apn = NULL;
-    char* proto = NULL;
-    char* username = NULL;
-    char* password = NULL;
+    RilBinderRadioParcel parcel;
+    const char* apn;
+    const char* proto;
+    const char* username;
+    const char* password;
     gint32 auth;
 
-    ril_binder_radio_init_parser(&parser, in);
-    if (grilio_parser_get_nullable_utf8(&parser, &apn) &&
-        grilio_parser_get_nullable_utf8(&parser, &proto) &&
-        grilio_parser_get_int32(&parser, &auth) &&
-        grilio_parser_get_nullable_utf8(&parser, &username) &&
-        grilio_parser_get_nullable_utf8(&parser, &password)) {
+    ril_binder_radio_parcel_init(&parcel, in, ctx);
+    if (ril_binder_radio_parcel_get_nullable_str(&parcel, &apn) &&
+        ril_binder_radio_parcel_get_nullable_str(&parcel, &proto) &&
+        ril_binder_radio_parcel_get_int32(&parcel, &auth) &&
+        ril_binder_radio_parcel_get_nullable_str(&parcel, &username) &&
+        ril_binder_radio_parcel_get_nullable_str(&parcel, &password)) {
         RadioDataProfile* profile;
         GBinderWriter writer;
 
         /* Initialize the writer and the data to be written */
         gbinder_local_request_init_writer(out, &writer);
-        profile = gbinder_writer_new0(&writer, RadioDataProfile);
-        ril_binder_radio_take_string(out, &profile->apn, apn);
-        ril_binder_radio_take_string(out, &profile->protocol, proto);
-        ril_binder_radio_take_string(out, &profile->user, username);
-        ril_binder_radio_take_string(out, &profile->password, password);
-        ril_binder_radio_take_string(out, &profile->mvnoMatchData, NULL);
+        profile = ril_binder_radio_encode_new0(ctx, RadioDataProfile);
+        ril_binder_radio_borrow_string(&profile->apn, apn);
+        ril_binder_radio_borrow_string(&profile->protocol, proto);
+        ril_binder_radio_borrow_string(&profile->user, username);
+        ril_binder_radio_borrow_string(&profile->password, password);
+        ril_binder_radio_borrow_string(&profile->mvnoMatchData, NULL);
         profile->roamingProtocol = profile->protocol;
         profile->authType = auth;
         profile->supportedApnTypesBitmap = RADIO_APN_TYPE_IA;
@@ -1413,7 +1923,8 @@ ril_binder_radio_encode_initial_attach_apn(
         /* int32_t serial */
         gbinder_writer_append_int32(&writer, grilio_request_serial(in));
         /* DataProfileInfo dataProfileInfo */
-        ril_binder_radio_write_single_data_profile(&writer, profile);
+        ril_binder_radio_write_struct(&writer,
+            &ril_binder_radio_layout_data_profile, profile);
         /* bool modemCognitive */
         gbinder_writer_append_bool(&writer, FALSE);
         /* bool isRoaming */
@@ -1421,10 +1932,6 @@ ril_binder_radio_encode_initial_attach_apn(
         gbinder_writer_append_bool(&writer, FALSE);
         return TRUE;
     }
-    g_free(apn);
-    g_free(proto);
-    g_free(username);
-    g_free(password);
     return FALSE;
 }
 
@@ -1437,21 +1944,24 @@ static
 gboolean
 ril_binder_radio_encode_data_profiles(
     GRilIoRequest* in,
-    GBinderLocalRequest* out)
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
 {
-    GRilIoParser parser;
+    RilBinderRadioParcel parcel;
     guint32 n;
 
-    ril_binder_radio_init_parser(&parser, in);
-    if (grilio_parser_get_uint32(&parser, &n)) {
+    /* Each profile takes at least 11 ints, don't allocate more than that */
+    ril_binder_radio_parcel_init(&parcel, in, ctx);
+    if (ril_binder_radio_parcel_get_uint32(&parcel, &n) &&
+        n <= (gsize)(parcel.end - parcel.ptr) / (11 * RIL_INT32_SIZE)) {
         guint i;
         GBinderWriter writer;
         GBinderHidlVec* vec;
         RadioDataProfile* profiles;
 
         gbinder_local_request_init_writer(out, &writer);
-        profiles = gbinder_writer_malloc0(&writer, sizeof(*profiles) * n);
-        vec = gbinder_writer_new0(&writer, GBinderHidlVec);
+        profiles = ril_binder_radio_encode_alloc0(ctx, sizeof(*profiles) * n);
+        vec = ril_binder_radio_encode_new0(ctx, GBinderHidlVec);
         vec->data.ptr = profiles;
         vec->count = n;
         vec->owns_buffer = TRUE;
@@ -1459,28 +1969,29 @@ ril_binder_radio_encode_data_profiles(
         for (i = 0; i < n; i++) {
             RadioDataProfile* dp = profiles + i;
             gint32 profile_id, type, auth_type, enabled;
-            char* apn = NULL;
-            char* proto = NULL;
-            char* username = NULL;
-            char* password = NULL;
-
-            if (grilio_parser_get_int32(&parser, &profile_id) &&
-                grilio_parser_get_nullable_utf8(&parser, &apn) &&
-                grilio_parser_get_nullable_utf8(&parser, &proto) &&
-                grilio_parser_get_int32(&parser, &auth_type) &&
-                grilio_parser_get_nullable_utf8(&parser, &username) &&
-                grilio_parser_get_nullable_utf8(&parser, &password) &&
-                grilio_parser_get_int32(&parser, &type) &&
-                grilio_parser_get_int32(&parser, &dp->maxConnsTime) &&
-                grilio_parser_get_int32(&parser, &dp->maxConns) &&
-                grilio_parser_get_int32(&parser, &dp->waitTime) &&
-                grilio_parser_get_int32(&parser, &enabled)) {
+            const char* apn;
+            const char* proto;
+            const char* username;
+            const char* password;
+            RilBinderRadioParcel* p = &parcel;
+
+            if (ril_binder_radio_parcel_get_int32(p, &profile_id) &&
+                ril_binder_radio_parcel_get_nullable_str(p, &apn) &&
+                ril_binder_radio_parcel_get_nullable_str(p, &proto) &&
+                ril_binder_radio_parcel_get_int32(p, &auth_type) &&
+                ril_binder_radio_parcel_get_nullable_str(p, &username) &&
+                ril_binder_radio_parcel_get_nullable_str(p, &password) &&
+                ril_binder_radio_parcel_get_int32(p, &type) &&
+                ril_binder_radio_parcel_get_int32(p, &dp->maxConnsTime) &&
+                ril_binder_radio_parcel_get_int32(p, &dp->maxConns) &&
+                ril_binder_radio_parcel_get_int32(p, &dp->waitTime) &&
+                ril_binder_radio_parcel_get_int32(p, &enabled)) {
                 /* Fill in the profile */
-                ril_binder_radio_take_string(out, &dp->apn, apn);
-                ril_binder_radio_take_string(out, &dp->protocol, proto);
-                ril_binder_radio_take_string(out, &dp->user, username);
-                ril_binder_radio_take_string(out, &dp->password, password);
-                ril_binder_radio_take_string(out, &dp->mvnoMatchData, NULL);
+                ril_binder_radio_borrow_string(&dp->apn, apn);
+                ril_binder_radio_borrow_string(&dp->protocol, proto);
+                ril_binder_radio_borrow_string(&dp->user, username);
+                ril_binder_radio_borrow_string(&dp->password, password);
+                ril_binder_radio_borrow_string(&dp->mvnoMatchData, NULL);
                 dp->type = type;
                 dp->roamingProtocol = dp->protocol;
                 dp->profileId = profile_id;
@@ -1489,16 +2000,11 @@ ril_binder_radio_encode_data_profiles(
                 dp->supportedApnTypesBitmap =
                     ril_binder_radio_apn_types_for_profile(profile_id);
             } else {
-                g_free(apn);
-                g_free(proto);
-                g_free(username);
-                g_free(password);
                 break;
             }
         }
 
         if (i == n) {
-            guint index;
             GBinderParent parent;
 
             /* int32_t serial */
@@ -1508,12 +2014,8 @@ ril_binder_radio_encode_data_profiles(
             parent.offset = GBINDER_HIDL_VEC_BUFFER_OFFSET;
             parent.index = gbinder_writer_append_buffer_object(&writer,
                 vec, sizeof(*vec));
-            index = gbinder_writer_append_buffer_object_with_parent(&writer,
-                profiles, sizeof(*profiles) * n, &parent);
-            for (i = 0; i < n; i++) {
-                ril_binder_radio_write_data_profile_strings(&writer,
-                    profiles + i, index, i);
-            }
+            ril_binder_radio_write_struct_array(&writer,
+                &ril_binder_radio_layout_data_profile, profiles, n, &parent);
 
             /* bool isRoaming */
             gbinder_writer_append_bool(&writer, FALSE);
@@ -1531,27 +2033,27 @@ static
 gboolean
 ril_binder_radio_encode_radio_capability(
     GRilIoRequest* in,
-    GBinderLocalRequest* out)
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
 {
-    GRilIoParser parser;
-    char* uuid = NULL;
+    RilBinderRadioParcel parcel;
+    const char* uuid;
     gint32 version, session, phase, raf, status;
 
-    ril_binder_radio_init_parser(&parser, in);
-    if (grilio_parser_get_int32(&parser, &version) &&
-        grilio_parser_get_int32(&parser, &session) &&
-        grilio_parser_get_int32(&parser, &phase) &&
-        grilio_parser_get_int32(&parser, &raf) &&
-        (uuid = grilio_parser_get_utf8(&parser)) != NULL &&
-        grilio_parser_get_int32(&parser, &status)) {
+    ril_binder_radio_parcel_init(&parcel, in, ctx);
+    if (ril_binder_radio_parcel_get_int32(&parcel, &version) &&
+        ril_binder_radio_parcel_get_int32(&parcel, &session) &&
+        ril_binder_radio_parcel_get_int32(&parcel, &phase) &&
+        ril_binder_radio_parcel_get_int32(&parcel, &raf) &&
+        (uuid = ril_binder_radio_parcel_get_str(&parcel)) != NULL &&
+        ril_binder_radio_parcel_get_int32(&parcel, &status)) {
         GBinderWriter writer;
         RadioCapability* rc;
-        guint index;
 
         /* Initialize the writer and the data to be written */
         gbinder_local_request_init_writer(out, &writer);
-        rc = gbinder_writer_new0(&writer, RadioCapability);
-        ril_binder_radio_take_string(out, &rc->logicalModemUuid, uuid);
+        rc = ril_binder_radio_encode_new0(ctx, RadioCapability);
+        ril_binder_radio_borrow_string(&rc->logicalModemUuid, uuid);
         rc->session = session;
         rc->phase = phase;
         rc->raf = raf;
@@ -1560,43 +2062,16 @@ ril_binder_radio_encode_radio_capability(
         /* Write the arguments */
         gbinder_writer_append_int32(&writer, grilio_request_serial(in));
 
-        /* Write the parent structure */
-        index = gbinder_writer_append_buffer_object(&writer, rc, sizeof(*rc));
-
-        /* Write the string data */
-        ril_binder_radio_write_hidl_string_data(&writer, rc, logicalModemUuid,
-            index);
+        /* Write the structure and the string data */
+        ril_binder_radio_write_struct(&writer,
+            &ril_binder_radio_layout_capability, rc);
         return TRUE;
     }
-    g_free(uuid);
     return FALSE;
 }
 
-static
-gboolean
-ril_binder_radio_encode_icc_open_logical_channel(
-    GRilIoRequest* in,
-    GBinderLocalRequest* out)
-{
-    GRilIoParser parser;
-    char* aid;
-
-    ril_binder_radio_init_parser(&parser, in);
-    aid = grilio_parser_get_utf8(&parser);
-    if (aid) {
-        GBinderWriter writer;
-        gint32 p2 = 0;
-
-        grilio_parser_get_int32(&parser, &p2); /* Optional? */
-        gbinder_local_request_cleanup(out, g_free, aid);
-        gbinder_local_request_init_writer(out, &writer);
-        gbinder_writer_append_int32(&writer, grilio_request_serial(in));
-        gbinder_writer_append_hidl_string(&writer, aid);
-        gbinder_writer_append_int32(&writer, p2);
-        return TRUE;
-    }
-    return FALSE;
-}
+RIL_BINDER_SCHEMA_ENCODER(icc_open_logical_channel, OP_(STR),
+    OP_(INT_OPT))
 
 /**
  * @param int32_t Serial number of request.
@@ -1606,37 +2081,33 @@ static
 gboolean
 ril_binder_radio_encode_icc_transmit_apdu_logical_channel(
     GRilIoRequest* in,
-    GBinderLocalRequest* out)
-{
-    GRilIoParser parser;
-    RadioSimApdu* apdu = g_new0(RadioSimApdu, 1);
-    char* data = NULL;
-
-    ril_binder_radio_init_parser(&parser, in);
-    if (grilio_parser_get_int32(&parser, &apdu->sessionId) &&
-        grilio_parser_get_int32(&parser, &apdu->cla) &&
-        grilio_parser_get_int32(&parser, &apdu->instruction) &&
-        grilio_parser_get_int32(&parser, &apdu->p1) &&
-        grilio_parser_get_int32(&parser, &apdu->p2) &&
-        grilio_parser_get_int32(&parser, &apdu->p3) &&
-        grilio_parser_get_nullable_utf8(&parser, &data)) {
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
+{
+    RilBinderRadioParcel parcel;
+    RadioSimApdu* apdu = ril_binder_radio_encode_new0(ctx, RadioSimApdu);
+    const char* data;
+
+    ril_binder_radio_parcel_init(&parcel, in, ctx);
+    if (ril_binder_radio_parcel_get_int32(&parcel, &apdu->sessionId) &&
+        ril_binder_radio_parcel_get_int32(&parcel, &apdu->cla) &&
+        ril_binder_radio_parcel_get_int32(&parcel, &apdu->instruction) &&
+        ril_binder_radio_parcel_get_int32(&parcel, &apdu->p1) &&
+        ril_binder_radio_parcel_get_int32(&parcel, &apdu->p2) &&
+        ril_binder_radio_parcel_get_int32(&parcel, &apdu->p3) &&
+        ril_binder_radio_parcel_get_nullable_str(&parcel, &data)) {
         GBinderWriter writer;
-        guint parent;
 
         /* Initialize the writer and the data to be written */
         gbinder_local_request_init_writer(out, &writer);
-        gbinder_local_request_cleanup(out, g_free, apdu);
-        ril_binder_radio_take_string(out, &apdu->data, data);
+        ril_binder_radio_borrow_string(&apdu->data, data);
 
         /* Write the arguments */
         gbinder_writer_append_int32(&writer, grilio_request_serial(in));
-        parent = gbinder_writer_append_buffer_object(&writer, apdu,
-            sizeof(*apdu));
-        ril_binder_radio_write_hidl_string_data(&writer, apdu, data, parent);
+        ril_binder_radio_write_struct(&writer,
+            &ril_binder_radio_layout_sim_apdu, apdu);
         return TRUE;
     }
-
-    g_free(apdu);
     return FALSE;
 }
 
@@ -1644,154 +2115,22 @@ ril_binder_radio_encode_icc_transmit_apdu_logical_channel(
  * Decoders (binder -> plugin)
  *==========================================================================*/
 
-static
-gboolean
-ril_binder_radio_decode_int32(
-    GBinderReader* in,
-    GByteArray* out)
-{
-    gint32 value;
-
-    if (gbinder_reader_read_int32(in, &value)) {
-        grilio_encode_int32(out, value);
-        return TRUE;
-    }
-    return FALSE;
-}
-
-static
-gboolean
-ril_binder_radio_decode_int_1(
-    GBinderReader* in,
-    GByteArray* out)
-{
-    gint32 value;
-
-    if (gbinder_reader_read_int32(in, &value)) {
-        grilio_encode_int32(out, 1);
-        grilio_encode_int32(out, value);
-        return TRUE;
-    }
-    return FALSE;
-}
-
-static
-gboolean
-ril_binder_radio_decode_int_2(
-    GBinderReader* in,
-    GByteArray* out)
-{
-    gint32 values[2];
-
-    if (gbinder_reader_read_int32(in, values + 0) &&
-        gbinder_reader_read_int32(in, values + 1)) {
-        grilio_encode_int32(out, 2);
-        grilio_encode_int32(out, values[0]);
-        grilio_encode_int32(out, values[1]);
-        return TRUE;
-    }
-    return FALSE;
-}
-
-static
-gboolean
-ril_binder_radio_decode_bool_to_int_array(
-    GBinderReader* in,
-    GByteArray* out)
-{
-    gint32 value;
-
-    if (gbinder_reader_read_bool(in, &value)) {
-        grilio_encode_int32(out, 1);
-        grilio_encode_int32(out, value);
-        return TRUE;
-    }
-    return FALSE;
-}
-
-static
-gboolean
-ril_binder_radio_decode_string(
-    GBinderReader* in,
-    GByteArray* out)
-{
-    const char* str = gbinder_reader_read_hidl_string_c(in);
-
-    if (str) {
-        grilio_encode_utf8(out, str);
-        return TRUE;
-    }
-    return FALSE;
-}
-
-static
-gboolean
-ril_binder_radio_decode_string_n(
-    GBinderReader* in,
-    GByteArray* out,
-    guint n)
-{
-    guint i;
-
-    grilio_encode_int32(out, n);
-    for (i = 0; i < n; i++) {
-        const char* str = gbinder_reader_read_hidl_string_c(in);
+RIL_BINDER_SCHEMA_DECODER(int32, OP_(INT))
 
-        if (str) {
-            grilio_encode_utf8(out, str);
-        } else {
-            return FALSE;
-        }
-    }
-    return TRUE;
-}
+RIL_BINDER_SCHEMA_DECODER(int_1, COUNT_(1), OP_(INT))
 
-static
-gboolean
-ril_binder_radio_decode_string_3(
-    GBinderReader* in,
-    GByteArray* out)
-{
-    return ril_binder_radio_decode_string_n(in, out, 3);
-}
+RIL_BINDER_SCHEMA_DECODER(int_2, COUNT_(2), OP_(INT), OP_(INT))
 
-static
-gboolean
-ril_binder_radio_decode_int_array(
-    GBinderReader* in,
-    GByteArray* out)
-{
-    gboolean ok = FALSE;
-    gsize n = 0;
-    const gint32* values = gbinder_reader_read_hidl_type_vec(in, gint32, &n);
+RIL_BINDER_SCHEMA_DECODER(bool_to_int_array, COUNT_(1), OP_(BOOL))
 
-    if (values) {
-        guint i;
+RIL_BINDER_SCHEMA_DECODER(string, OP_(STR))
 
-        grilio_encode_int32(out, n);
-        for (i = 0; i < n; i++) {
-            grilio_encode_int32(out, values[i]);
-        }
-        ok = TRUE;
-    }
-    return ok;
-}
+RIL_BINDER_SCHEMA_DECODER(string_3, COUNT_(3), OP_(STR), OP_(STR),
+    OP_(STR))
 
-static
-gboolean
-ril_binder_radio_decode_byte_array(
-    GBinderReader* in,
-    GByteArray* out)
-{
-    gsize size = 0;
-    const guint8* ptr = gbinder_reader_read_hidl_byte_vec(in, &size);
+RIL_BINDER_SCHEMA_DECODER(int_array, OP_(INTS))
 
-    if (ptr) {
-        g_byte_array_append(out, ptr, size);
-        return TRUE;
-    }
-    return FALSE;
-}
+RIL_BINDER_SCHEMA_DECODER(byte_array, OP_(BYTES))
 
 static
 gboolean
@@ -1822,6 +2161,26 @@ ril_binder_radio_decode_byte_array_to_hex(
     return FALSE;
 }
 
+static
+gsize
+ril_binder_vec_utf8_as_string_size(
+    const GBinderHidlVec *vec,
+    const char *separator)
+{
+    const GBinderHidlString* elem = vec->data.ptr;
+    gsize chars = 0;
+    guint i;
+
+    /* Same limit as in ril_binder_decode_vec_utf8_as_string() */
+    for (i = 0; i < vec->count; i++) {
+        if (i) {
+            chars += strlen(separator);
+        }
+        chars += elem[i].len;
+    }
+    return RIL_INT32_SIZE + ALIGN4((MIN(chars, 255) + 1) * 2);
+}
+
 static
 void
 ril_binder_decode_vec_utf8_as_string(
@@ -1845,6 +2204,22 @@ ril_binder_decode_vec_utf8_as_string(
     grilio_encode_utf8(out, str);
 }
 
+static
+gsize
+ril_binder_radio_data_call_1_4_size(
+    const RadioDataCall_1_4* call)
+{
+    const char* type = radio_pdp_protocol_type_to_str(call->type);
+
+    return 5 * RIL_INT32_SIZE +
+        ril_binder_radio_utf8_size(type) +
+        ril_binder_radio_utf8_size(call->ifname.data.str) +
+        ril_binder_vec_utf8_as_string_size(&call->addresses, " ") +
+        ril_binder_vec_utf8_as_string_size(&call->dnses, " ") +
+        ril_binder_vec_utf8_as_string_size(&call->gateways, " ") +
+        ril_binder_vec_utf8_as_string_size(&call->pcscf, " ");
+}
+
 static
 void
 ril_binder_radio_decode_data_call_1_4(
@@ -1874,8 +2249,16 @@ ril_binder_radio_decode_icc_card_status(
     GByteArray* out)
 {
     const RadioAppStatus* apps = sim->apps.data.ptr;
+    gsize size = 6 * RIL_INT32_SIZE;
     guint i;
 
+    for (i = 0; i < sim->apps.count; i++) {
+        size += 6 * RIL_INT32_SIZE +
+            ril_binder_radio_utf8_size(apps[i].aid.data.str) +
+            ril_binder_radio_utf8_size(apps[i].label.data.str);
+    }
+    ril_binder_radio_reserve(out, size);
+
     grilio_encode_int32(out, sim->cardState);
     grilio_encode_int32(out, sim->universalPinState);
     grilio_encode_int32(out, sim->gsmUmtsSubscriptionAppIndex);
@@ -2086,8 +2469,15 @@ ril_binder_radio_decode_call_forward_info_array(
         (in, RadioCallForwardInfo, &count);
 
     if (infos) {
+        gsize size = RIL_INT32_SIZE;
         guint i;
 
+        for (i = 0; i < count; i++) {
+            size += 5 * RIL_INT32_SIZE +
+                ril_binder_radio_utf8_size(infos[i].number.data.str);
+        }
+        ril_binder_radio_reserve(out, size);
+
         grilio_encode_int32(out, count);
         for (i = 0; i < count; i++) {
             const RadioCallForwardInfo* info = infos + i;
@@ -2104,6 +2494,16 @@ ril_binder_radio_decode_call_forward_info_array(
     return ok;
 }
 
+static
+gsize
+ril_binder_radio_call_size(
+    const RadioCall* call)
+{
+    return 11 * RIL_INT32_SIZE +
+        ril_binder_radio_utf8_size(call->number.data.str) +
+        ril_binder_radio_utf8_size(call->name.data.str);
+}
+
 /**
  * @param calls Current call list
  */
@@ -2140,9 +2540,15 @@ ril_binder_radio_decode_call_list(
         (in, RadioCall, &count);
 
     if (calls) {
+        gsize size = RIL_INT32_SIZE;
         guint i;
 
-        grilio_encode_int32(out, count);
+        for (i = 0; i < count; i++) {
+            size += ril_binder_radio_call_size(calls + i);
+        }
+        ril_binder_radio_reserve(out, size);
+
+        grilio_encode_int32(out, count);
         for (i = 0; i < count; i++) {
             ril_binder_radio_decode_call(calls + i, out);
         }
@@ -2166,8 +2572,14 @@ ril_binder_radio_decode_call_list_1_2(
         (in, RadioCall_1_2, &count);
 
     if (calls) {
+        gsize size = RIL_INT32_SIZE;
         guint i;
 
+        for (i = 0; i < count; i++) {
+            size += ril_binder_radio_call_size(&calls[i].base);
+        }
+        ril_binder_radio_reserve(out, size);
+
         grilio_encode_int32(out, count);
         for (i = 0; i < count; i++) {
             ril_binder_radio_decode_call(&calls[i].base, out);
@@ -2222,6 +2634,16 @@ ril_binder_radio_decode_call_waiting(
     return FALSE;
 }
 
+static
+const char*
+ril_binder_radio_operator_status_str(
+    gint32 status)
+{
+    return (status == RADIO_OP_AVAILABLE) ? "available" :
+        (status == RADIO_OP_CURRENT) ? "current" :
+        (status == RADIO_OP_FORBIDDEN) ? "forbidden" : "unknown";
+}
+
 /**
  * @param networkInfos List of network operator information as OperatorInfos
  *                     defined in types.hal
@@ -2238,8 +2660,20 @@ ril_binder_radio_decode_operator_info_list(
         (in, RadioOperatorInfo, &count);
 
     if (ops) {
+        gsize size = RIL_INT32_SIZE;
         guint i;
 
+        for (i = 0; i < count; i++) {
+            const RadioOperatorInfo* op = ops + i;
+
+            size += ril_binder_radio_utf8_size(op->alphaLong.data.str) +
+                ril_binder_radio_utf8_size(op->alphaShort.data.str) +
+                ril_binder_radio_utf8_size(op->operatorNumeric.data.str) +
+                ril_binder_radio_utf8_size
+                    (ril_binder_radio_operator_status_str(op->status));
+        }
+        ril_binder_radio_reserve(out, size);
+
         /* 4 strings per operator */
         grilio_encode_int32(out, 4*count);
         for (i = 0; i < count; i++) {
@@ -2249,9 +2683,7 @@ ril_binder_radio_decode_operator_info_list(
             grilio_encode_utf8(out, op->alphaShort.data.str);
             grilio_encode_utf8(out, op->operatorNumeric.data.str);
             grilio_encode_utf8(out,
-                (op->status == RADIO_OP_AVAILABLE) ? "available" :
-                (op->status == RADIO_OP_CURRENT) ? "current" :
-                (op->status == RADIO_OP_FORBIDDEN) ? "forbidden" : "unknown");
+                ril_binder_radio_operator_status_str(op->status));
         }
         ok = TRUE;
     }
@@ -2273,8 +2705,22 @@ ril_binder_radio_decode_data_call_list(
         (in, RadioDataCall, &count);
 
     if (calls) {
+        gsize size = 2 * RIL_INT32_SIZE;
         guint i;
 
+        for (i = 0; i < count; i++) {
+            const RadioDataCall* call = calls + i;
+
+            size += 5 * RIL_INT32_SIZE +
+                ril_binder_radio_utf8_size(call->type.data.str) +
+                ril_binder_radio_utf8_size(call->ifname.data.str) +
+                ril_binder_radio_utf8_size(call->addresses.data.str) +
+                ril_binder_radio_utf8_size(call->dnses.data.str) +
+                ril_binder_radio_utf8_size(call->gateways.data.str) +
+                ril_binder_radio_utf8_size(call->pcscf.data.str);
+        }
+        ril_binder_radio_reserve(out, size);
+
         grilio_encode_int32(out, DATA_CALL_VERSION);
         grilio_encode_int32(out, count);
         for (i = 0; i < count; i++) {
@@ -2300,8 +2746,14 @@ ril_binder_radio_decode_data_call_list_1_4(
         (in, RadioDataCall_1_4, &count);
 
     if (calls) {
+        gsize size = 2 * RIL_INT32_SIZE;
         guint i;
 
+        for (i = 0; i < count; i++) {
+            size += ril_binder_radio_data_call_1_4_size(calls + i);
+        }
+        ril_binder_radio_reserve(out, size);
+
         grilio_encode_int32(out, DATA_CALL_VERSION);
         grilio_encode_int32(out, count);
         for (i = 0; i < count; i++) {
@@ -3027,6 +3479,7 @@ ril_binder_radio_decode_cell_info_list(
         (in, RadioCellInfo, &count);
 
     if (cells) {
+        gsize size = RIL_INT32_SIZE;
         guint i, n = 0;
 
         /* Count supported types */
@@ -3036,22 +3489,33 @@ ril_binder_radio_decode_cell_info_list(
             switch (cells[i].cellInfoType) {
             case RADIO_CELL_INFO_GSM:
                 n += cell->gsm.count;
+                size += cell->gsm.count * (RIL_CELL_INFO_HEADER_SIZE +
+                    RIL_CELL_INFO_GSM_SIZE);
                 break;
             case RADIO_CELL_INFO_CDMA:
                 n += cell->cdma.count;
+                size += cell->cdma.count * (RIL_CELL_INFO_HEADER_SIZE +
+                    RIL_CELL_INFO_CDMA_SIZE);
                 break;
             case RADIO_CELL_INFO_LTE:
                 n += cell->lte.count;
+                size += cell->lte.count * (RIL_CELL_INFO_HEADER_SIZE +
+                    RIL_CELL_INFO_LTE_SIZE);
                 break;
             case RADIO_CELL_INFO_WCDMA:
                 n += cell->wcdma.count;
+                size += cell->wcdma.count * (RIL_CELL_INFO_HEADER_SIZE +
+                    RIL_CELL_INFO_WCDMA_SIZE);
                 break;
             case RADIO_CELL_INFO_TD_SCDMA:
                 n += cell->tdscdma.count;
+                size += cell->tdscdma.count * (RIL_CELL_INFO_HEADER_SIZE +
+                    RIL_CELL_INFO_TDSCDMA_SIZE);
                 break;
             }
         }
 
+        ril_binder_radio_reserve(out, size);
         grilio_encode_int32(out, n);
 
         for (i = 0; i < count; i++) {
@@ -3095,6 +3559,7 @@ ril_binder_radio_decode_cell_info_list_1_2(
         (in, RadioCellInfo_1_2, &count);
 
     if (cells) {
+        gsize size = RIL_INT32_SIZE;
         guint i, n = 0;
 
         /* Count supported types */
@@ -3104,22 +3569,33 @@ ril_binder_radio_decode_cell_info_list_1_2(
             switch (cells[i].cellInfoType) {
             case RADIO_CELL_INFO_GSM:
                 n += cell->gsm.count;
+                size += cell->gsm.count * (RIL_CELL_INFO_HEADER_SIZE +
+                    RIL_CELL_INFO_GSM_SIZE);
                 break;
             case RADIO_CELL_INFO_CDMA:
                 n += cell->cdma.count;
+                size += cell->cdma.count * (RIL_CELL_INFO_HEADER_SIZE +
+                    RIL_CELL_INFO_CDMA_SIZE);
                 break;
             case RADIO_CELL_INFO_LTE:
                 n += cell->lte.count;
+                size += cell->lte.count * (RIL_CELL_INFO_HEADER_SIZE +
+                    RIL_CELL_INFO_LTE_SIZE);
                 break;
             case RADIO_CELL_INFO_WCDMA:
                 n += cell->wcdma.count;
+                size += cell->wcdma.count * (RIL_CELL_INFO_HEADER_SIZE +
+                    RIL_CELL_INFO_WCDMA_SIZE);
                 break;
             case RADIO_CELL_INFO_TD_SCDMA:
                 n += cell->tdscdma.count;
+                size += cell->tdscdma.count * (RIL_CELL_INFO_HEADER_SIZE +
+                    RIL_CELL_INFO_TDSCDMA_SIZE);
                 break;
             }
         }
 
+        ril_binder_radio_reserve(out, size);
         grilio_encode_int32(out, n);
 
         for (i = 0; i < count; i++) {
@@ -3163,17 +3639,31 @@ ril_binder_radio_decode_cell_info_list_1_4(
         (in, RadioCellInfo_1_4, &count);
 
     if (cells) {
+        gsize size = RIL_INT32_SIZE;
         guint i, n = 0;
 
         /* Count supported types */
         for (i = 0; i < count; i++) {
             switch (cells[i].cellInfoType) {
             case RADIO_CELL_INFO_1_4_GSM:
+                n++;
+                size += RIL_CELL_INFO_HEADER_SIZE + RIL_CELL_INFO_GSM_SIZE;
+                break;
             case RADIO_CELL_INFO_1_4_CDMA:
+                n++;
+                size += RIL_CELL_INFO_HEADER_SIZE + RIL_CELL_INFO_CDMA_SIZE;
+                break;
             case RADIO_CELL_INFO_1_4_WCDMA:
+                n++;
+                size += RIL_CELL_INFO_HEADER_SIZE + RIL_CELL_INFO_WCDMA_SIZE;
+                break;
             case RADIO_CELL_INFO_1_4_LTE:
+                n++;
+                size += RIL_CELL_INFO_HEADER_SIZE + RIL_CELL_INFO_LTE_SIZE;
+                break;
             case RADIO_CELL_INFO_1_4_TD_SCDMA:
                 n++;
+                size += RIL_CELL_INFO_HEADER_SIZE + RIL_CELL_INFO_TDSCDMA_SIZE;
                 break;
             /* Do not count 5G cells for now */
             case RADIO_CELL_INFO_1_4_NR:
@@ -3181,6 +3671,7 @@ ril_binder_radio_decode_cell_info_list_1_4(
             }
         }
 
+        ril_binder_radio_reserve(out, size);
         grilio_encode_int32(out, n);
 
         for (i = 0; i < count; i++) {
@@ -3236,41 +3727,10 @@ ril_binder_radio_decode_cell_info_list_1_4(
  * @param bool true = registered, false = not registered
  * @param RadioTechnologyFamily (int32).
  */
-static
-gboolean
-ril_binder_radio_decode_ims_registration_state(
-    GBinderReader* in,
-    GByteArray* out)
-{
-    gboolean reg;
-    gint32 family;
-
-    if (gbinder_reader_read_bool(in, &reg) &&
-        gbinder_reader_read_int32(in, &family)) {
-        grilio_encode_int32(out, 2); /* Number of ints to follow */
-        grilio_encode_int32(out, reg);
-        grilio_encode_int32(out, family);
-        return TRUE;
-    }
-    return FALSE;
-}
-
-static
-gboolean
-ril_binder_radio_decode_icc_open_logical_channel(
-    GBinderReader* in,
-    GByteArray* out)
-{
-    guint32 channel;
+RIL_BINDER_SCHEMA_DECODER(ims_registration_state, COUNT_(2), OP_(BOOL),
+    OP_(INT))
 
-    if (gbinder_reader_read_uint32(in, &channel)) {
-        grilio_encode_int32(out, 1); /* Number of ints to follow */
-        grilio_encode_int32(out, channel);
-        /* Ignore the select response, ofono doesn't need it */
-        return TRUE;
-    }
-    return FALSE;
-}
+RIL_BINDER_SCHEMA_DECODER(icc_open_logical_channel, COUNT_(1), OP_(INT))
 
 /**
  * @param rc Radio capability as defined by RadioCapability
@@ -4177,50 +4637,1557 @@ static const RilBinderRadioEvent ril_binder_radio_events_1_4[] = {
 };
 
 /*==========================================================================*
- * Generic failure
+ * Dispatch tables
  *==========================================================================*/
 
+static const RilBinderRadioInterfaceDesc ril_binder_radio_interfaces[] = {
+    {
+        /* android.hardware.radio@1.0 */
+        RADIO_INTERFACE_1_0,
+        ARRAY_AND_COUNT(ril_binder_radio_calls_1_0),
+        ARRAY_AND_COUNT(ril_binder_radio_events_1_0)
+    },{
+        /* android.hardware.radio@1.2 */
+        RADIO_INTERFACE_1_2,
+        ARRAY_AND_COUNT(ril_binder_radio_calls_1_2),
+        ARRAY_AND_COUNT(ril_binder_radio_events_1_2)
+    },{
+        /* android.hardware.radio@1.4 */
+        RADIO_INTERFACE_1_4,
+        ARRAY_AND_COUNT(ril_binder_radio_calls_1_4),
+        ARRAY_AND_COUNT(ril_binder_radio_events_1_4)
+    }
+};
+
+/* Only accessed on the main thread */
+static RilBinderRadioTables* ril_binder_radio_tables_cache
+    [RADIO_INTERFACE_COUNT];
+
+static
+RilBinderRadioTables*
+ril_binder_radio_tables_new(
+    RADIO_INTERFACE version)
+{
+    RilBinderRadioTables* tables;
+    guint req_count = 0, resp_count = 0, unsol_count = 0;
+    guint i, k;
+    gpointer* ptr;
+
+    /* Figure out the size of each table */
+    for (i = 0; i < G_N_ELEMENTS(ril_binder_radio_interfaces); i++) {
+        const RilBinderRadioInterfaceDesc* desc =
+            ril_binder_radio_interfaces + i;
+
+        if (desc->version <= version) {
+            for (k = 0; k < desc->num_calls; k++) {
+                const RilBinderRadioCall* call = desc->calls + k;
+
+                if (call->req_tx) {
+                    req_count = MAX(req_count, call->code + 1);
+                }
+                if (call->resp_tx) {
+                    resp_count = MAX(resp_count, (guint)call->resp_tx + 1);
+                }
+            }
+            for (k = 0; k < desc->num_events; k++) {
+                unsol_count = MAX(unsol_count,
+                    (guint)desc->events[k].unsol_tx + 1);
+            }
+        }
+    }
+
+    /* Everything is allocated as a single block */
+    tables = g_malloc0(sizeof(RilBinderRadioTables) +
+        sizeof(gpointer) * (req_count + resp_count + unsol_count));
+    ptr = (gpointer*)(tables + 1);
+    tables->ref_count = 1;
+    tables->version = version;
+    tables->req = (const RilBinderRadioCall**)ptr;
+    tables->req_count = req_count;
+    ptr += req_count;
+    tables->resp = (const RilBinderRadioCall**)ptr;
+    tables->resp_count = resp_count;
+    ptr += resp_count;
+    tables->unsol = (const RilBinderRadioEvent**)ptr;
+    tables->unsol_count = unsol_count;
+
+    /* Newer interfaces override older ones */
+    for (i = 0; i < G_N_ELEMENTS(ril_binder_radio_interfaces); i++) {
+        const RilBinderRadioInterfaceDesc* desc =
+            ril_binder_radio_interfaces + i;
+
+        if (desc->version <= version) {
+            for (k = 0; k < desc->num_calls; k++) {
+                const RilBinderRadioCall* call = desc->calls + k;
+
+                if (call->req_tx) {
+                    tables->req[call->code] = call;
+                }
+                if (call->resp_tx) {
+                    tables->resp[call->resp_tx] = call;
+                }
+            }
+            for (k = 0; k < desc->num_events; k++) {
+                const RilBinderRadioEvent* event = desc->events + k;
+
+                tables->unsol[event->unsol_tx] = event;
+            }
+        }
+    }
+    return tables;
+}
+
+static
+RilBinderRadioTables*
+ril_binder_radio_tables_get(
+    RADIO_INTERFACE version)
+{
+    RilBinderRadioTables* tables;
+
+    version = MIN(version, RADIO_INTERFACE_COUNT - 1);
+    tables = ril_binder_radio_tables_cache[version];
+    if (tables) {
+        tables->ref_count++;
+    } else {
+        tables = ril_binder_radio_tables_new(version);
+        ril_binder_radio_tables_cache[version] = tables;
+    }
+    return tables;
+}
+
+static
+gsize
+ril_binder_radio_tables_size(
+    const RilBinderRadioTables* tables)
+{
+    /* Shared tables are charged in full to each instance using them */
+    return sizeof(*tables) + sizeof(gpointer) *
+        (tables->req_count + tables->resp_count + tables->unsol_count);
+}
+
 static
 void
-ril_binder_radio_generic_failure_run(
-    gpointer data)
+ril_binder_radio_tables_unref(
+    RilBinderRadioTables* tables)
+{
+    if (tables && !(--tables->ref_count)) {
+        GASSERT(ril_binder_radio_tables_cache[tables->version] == tables);
+        ril_binder_radio_tables_cache[tables->version] = NULL;
+        g_free(tables);
+    }
+}
+
+static
+inline
+const RilBinderRadioCall*
+ril_binder_radio_tables_req(
+    const RilBinderRadioTables* tables,
+    guint code)
 {
-    RilBinderRadioFailureData* failure = data;
-    GRilIoTransport* transport = failure->transport;
+    return (tables && code < tables->req_count) ? tables->req[code] : NULL;
+}
 
-    grilio_transport_ref(transport);
-    grilio_transport_signal_response(transport, GRILIO_RESPONSE_SOLICITED,
-        failure->serial, RIL_E_GENERIC_FAILURE, NULL, 0);
-    grilio_transport_unref(transport);
+static
+inline
+const RilBinderRadioCall*
+ril_binder_radio_tables_resp(
+    const RilBinderRadioTables* tables,
+    RADIO_RESP code)
+{
+    return (tables && (guint)code < tables->resp_count) ?
+        tables->resp[code] : NULL;
+}
+
+static
+inline
+const RilBinderRadioEvent*
+ril_binder_radio_tables_unsol(
+    const RilBinderRadioTables* tables,
+    RADIO_IND code)
+{
+    return (tables && (guint)code < tables->unsol_count) ?
+        tables->unsol[code] : NULL;
+}
+
+/*==========================================================================*
+ * Latency
+ *==========================================================================*/
+
+/* Upper limits of the histogram buckets, in microseconds */
+static const guint ril_binder_radio_latency_limits
+    [RIL_BINDER_RADIO_LATENCY_BUCKETS] = {
+    1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000,
+    500000, 1000000, 5000000, G_MAXUINT
+};
+
+static
+guint
+ril_binder_radio_latency_bucket(
+    guint us)
+{
+    guint i = 0;
+
+    while (us > ril_binder_radio_latency_limits[i]) {
+        i++;
+    }
+    return i;
 }
 
 static
 void
-ril_binder_radio_generic_failure_free(
-    gpointer data)
+ril_binder_radio_latency_start(
+    RilBinderRadio* self,
+    const char* name,
+    guint serial)
 {
-    g_slice_free1(sizeof(RilBinderRadioFailureData), data);
+    RilBinderRadioPending* pending = self->priv->pending +
+        (serial % RIL_BINDER_PENDING_SIZE);
+
+    /* If the slot is still occupied, the older request is forgotten */
+    pending->name = name;
+    pending->serial = serial;
+    pending->start = g_get_monotonic_time();
 }
 
 static
-GRILIO_SEND_STATUS
-ril_binder_radio_generic_failure(
+RilBinderRadioLatency*
+ril_binder_radio_latency_entry(
     RilBinderRadio* self,
-    GRilIoRequest* req)
+    const char* name)
 {
-    if (self->radio) {
-        RilBinderRadioPriv* priv = self->priv;
-        RilBinderRadioFailureData* failure =
-            g_slice_new(RilBinderRadioFailureData);
-
-        failure->transport = &self->parent;
-        failure->serial = grilio_request_serial(req);
-        gutil_idle_queue_add_full(priv->idle,
-            ril_binder_radio_generic_failure_run, failure,
-            ril_binder_radio_generic_failure_free);
-        return GRILIO_SEND_OK;
+    RilBinderRadioPriv* priv = self->priv;
+    RilBinderRadioLatency* latency;
+
+    if (!priv->latency) {
+        priv->latency = g_hash_table_new_full(g_str_hash, g_str_equal,
+            NULL, g_free);
+    }
+    latency = g_hash_table_lookup(priv->latency, name);
+    if (!latency) {
+        latency = g_new0(RilBinderRadioLatency, 1);
+        latency->name = name;
+        g_hash_table_insert(priv->latency, (gpointer)name, latency);
+    }
+    return latency;
+}
+
+static
+void
+ril_binder_radio_latency_ack(
+    RilBinderRadio* self,
+    guint serial)
+{
+    RilBinderRadioPending* pending = self->priv->pending +
+        (serial % RIL_BINDER_PENDING_SIZE);
+
+    if (pending->name && pending->serial == serial) {
+        RilBinderRadioLatency* latency =
+            ril_binder_radio_latency_entry(self, pending->name);
+        const guint us = (guint)MIN(g_get_monotonic_time() - pending->start,
+            G_MAXUINT);
+
+        latency->ack_count++;
+        latency->ack_total_us += us;
+        latency->ack[ril_binder_radio_latency_bucket(us)]++;
+    }
+}
+
+static
+void
+ril_binder_radio_latency_finish(
+    RilBinderRadio* self,
+    guint serial)
+{
+    RilBinderRadioPending* pending = self->priv->pending +
+        (serial % RIL_BINDER_PENDING_SIZE);
+
+    if (pending->name && pending->serial == serial) {
+        RilBinderRadioLatency* latency =
+            ril_binder_radio_latency_entry(self, pending->name);
+        const guint us = (guint)MIN(g_get_monotonic_time() - pending->start,
+            G_MAXUINT);
+
+        latency->resp_count++;
+        latency->resp_total_us += us;
+        latency->resp_max_us = MAX(latency->resp_max_us, us);
+        latency->resp[ril_binder_radio_latency_bucket(us)]++;
+        pending->name = NULL;
+    }
+}
+
+static
+void
+ril_binder_radio_latency_cancel(
+    RilBinderRadio* self,
+    guint serial)
+{
+    RilBinderRadioPending* pending = self->priv->pending +
+        (serial % RIL_BINDER_PENDING_SIZE);
+
+    if (pending->serial == serial) {
+        pending->name = NULL;
+    }
+}
+
+/*==========================================================================*
+ * Indication counters
+ *==========================================================================*/
+
+static
+guint
+ril_binder_radio_ind_epoch(
+    void)
+{
+    return (guint)(g_get_monotonic_time() /
+        (G_USEC_PER_SEC * RIL_BINDER_IND_WINDOW_SLOT_SEC));
+}
+
+static
+RilBinderRadioIndCounters*
+ril_binder_radio_ind_counters(
+    RilBinderRadio* self,
+    RADIO_IND code)
+{
+    RilBinderRadioPriv* priv = self->priv;
+    const guint n = priv->tables ? priv->tables->unsol_count : 0;
+
+    if (!priv->ind) {
+        priv->ind = g_new0(RilBinderRadioIndCounters, n + 1);
+    }
+    return priv->ind + MIN((guint)code, n);
+}
+
+static
+void
+ril_binder_radio_ind_count(
+    RilBinderRadioIndCounters* ind)
+{
+    const guint epoch = ril_binder_radio_ind_epoch();
+    const guint i = epoch % RIL_BINDER_IND_WINDOW_SLOTS;
+
+    if (ind->epoch[i] != epoch) {
+        ind->epoch[i] = epoch;
+        ind->window[i] = 0;
+    }
+    ind->window[i]++;
+    ind->count++;
+}
+
+static
+guint
+ril_binder_radio_ind_last_minute(
+    const RilBinderRadioIndCounters* ind,
+    guint epoch)
+{
+    guint i, sum = 0;
+
+    for (i = 0; i < RIL_BINDER_IND_WINDOW_SLOTS; i++) {
+        if (ind->epoch[i] + RIL_BINDER_IND_WINDOW_SLOTS > epoch) {
+            sum += ind->window[i];
+        }
+    }
+    return sum;
+}
+
+static
+gint
+ril_binder_radio_ind_stats_compare(
+    gconstpointer a,
+    gconstpointer b,
+    gpointer user_data)
+{
+    const RilBinderRadioIndStats* s1 = a;
+    const RilBinderRadioIndStats* s2 = b;
+
+    if (s1->last_minute != s2->last_minute) {
+        return (s1->last_minute > s2->last_minute) ? -1 : 1;
+    } else if (s1->count != s2->count) {
+        return (s1->count > s2->count) ? -1 : 1;
+    } else {
+        return (s1->code < s2->code) ? -1 : (s1->code > s2->code);
+    }
+}
+
+/*==========================================================================*
+ * Profiling
+ *
+ * Built with "make profile", every encoder and decoder invocation is
+ * timed and the totals are reported by ril_binder_radio_profile_report().
+ * Otherwise the encoders and decoders are invoked directly.
+ *==========================================================================*/
+
+#ifdef RIL_BINDER_PROFILE
+
+/* Name -> RilBinderRadioProfile, only touched on the main thread */
+static GHashTable* ril_binder_radio_profile_encoders = NULL;
+static GHashTable* ril_binder_radio_profile_decoders = NULL;
+
+/* Provided by libril-binder-alloc.so if it's preloaded */
+typedef unsigned long (*RilBinderRadioAllocCountFunc)(void);
+static RilBinderRadioAllocCountFunc ril_binder_radio_alloc_count = NULL;
+static gboolean ril_binder_radio_alloc_count_resolved = FALSE;
+
+#define RIL_BINDER_PROFILE_FILE_ENV "RIL_BINDER_PROFILE_FILE"
+#define RIL_BINDER_PROFILE_FILE "ril-binder-profile.tsv"
+
+typedef struct ril_binder_radio_profile_scope {
+    RilBinderRadioProfile* prof;
+    gulong allocs;
+    guint64 start;
+} RilBinderRadioProfileScope;
+
+static
+gulong
+ril_binder_radio_profile_allocs(
+    void)
+{
+    if (!ril_binder_radio_alloc_count_resolved) {
+        ril_binder_radio_alloc_count_resolved = TRUE;
+        ril_binder_radio_alloc_count = (RilBinderRadioAllocCountFunc)
+            dlsym(RTLD_DEFAULT, "ril_binder_alloc_count");
+        GINFO("Allocation counting %s", ril_binder_radio_alloc_count ?
+            "enabled" : "unavailable");
+    }
+    return ril_binder_radio_alloc_count ? ril_binder_radio_alloc_count() : 0;
+}
+
+static
+guint64
+ril_binder_radio_profile_ns(
+    void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((guint64)ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+static
+RilBinderRadioProfile*
+ril_binder_radio_profile_get(
+    GHashTable** table,
+    const char* kind,
+    const char* name)
+{
+    RilBinderRadioProfile* prof;
+
+    if (!*table) {
+        *table = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, g_free);
+    }
+    prof = g_hash_table_lookup(*table, name);
+    if (!prof) {
+        prof = g_new0(RilBinderRadioProfile, 1);
+        prof->name = name;
+        prof->kind = kind;
+        g_hash_table_insert(*table, (gpointer)name, prof);
+    }
+    return prof;
+}
+
+static
+void
+ril_binder_radio_profile_add(
+    RilBinderRadioProfile* prof,
+    guint64 start,
+    gulong allocs,
+    gsize in_bytes,
+    gsize bytes)
+{
+    const guint64 ns = ril_binder_radio_profile_ns() - start;
+
+    allocs = ril_binder_radio_profile_allocs() - allocs;
+    prof->calls++;
+    prof->total_ns += ns;
+    prof->in_bytes += in_bytes;
+    prof->bytes += bytes;
+    prof->allocs += allocs;
+    if (prof->max_ns < ns) {
+        prof->max_ns = ns;
+    }
+    if (prof->max_allocs < allocs) {
+        prof->max_allocs = allocs;
+    }
+}
+
+static
+void
+ril_binder_radio_profile_begin(
+    RilBinderRadioProfileScope* scope,
+    const char* kind,
+    const char* name)
+{
+    scope->prof = ril_binder_radio_profile_get
+        (&ril_binder_radio_profile_decoders, kind, name);
+    scope->allocs = ril_binder_radio_profile_allocs();
+    scope->start = ril_binder_radio_profile_ns();
+}
+
+static
+void
+ril_binder_radio_profile_end(
+    RilBinderRadioProfileScope* scope)
+{
+    ril_binder_radio_profile_add(scope->prof, scope->start, scope->allocs,
+        0, 0);
+}
+
+static
+void
+ril_binder_radio_profile_decoder(
+    RilBinderRadio* self,
+    const char* name)
+{
+    self->priv->prof_decode = name ? ril_binder_radio_profile_get
+        (&ril_binder_radio_profile_decoders, "decode", name) : NULL;
+}
+
+static
+int
+ril_binder_radio_profile_compare(
+    gconstpointer a,
+    gconstpointer b)
+{
+    const RilBinderRadioProfile* p1 = *(RilBinderRadioProfile**)a;
+    const RilBinderRadioProfile* p2 = *(RilBinderRadioProfile**)b;
+
+    return (p1->total_ns > p2->total_ns) ? -1 :
+        (p1->total_ns < p2->total_ns) ? 1 : strcmp(p1->name, p2->name);
+}
+
+static
+void
+ril_binder_radio_profile_collect(
+    GPtrArray* list,
+    GHashTable* table)
+{
+    if (table) {
+        GHashTableIter it;
+        gpointer value;
+
+        g_hash_table_iter_init(&it, table);
+        while (g_hash_table_iter_next(&it, NULL, &value)) {
+            g_ptr_array_add(list, value);
+        }
+    }
+}
+
+static
+void
+ril_binder_radio_profile_write(
+    GPtrArray* list)
+{
+    const char* env = g_getenv(RIL_BINDER_PROFILE_FILE_ENV);
+    char* path = (env && env[0]) ? g_strdup(env) :
+        g_build_filename(g_get_tmp_dir(), RIL_BINDER_PROFILE_FILE, NULL);
+    GString* out = g_string_new("kind\tname\tcalls\tns/op\tmax_ns"
+        "\tin_bytes/op\tbytes/op\tallocs/op\tmax_allocs\n");
+    GError* error = NULL;
+    guint i;
+
+    /* One line per function, tab separated, easy to diff and plot */
+    for (i = 0; i < list->len; i++) {
+        const RilBinderRadioProfile* prof = list->pdata[i];
+
+        g_string_append_printf(out, "%s\t%s\t%" G_GUINT64_FORMAT
+            "\t%.1f\t%" G_GUINT64_FORMAT "\t%.1f\t%.1f\t", prof->kind,
+            prof->name, prof->calls, (double)prof->total_ns / prof->calls,
+            prof->max_ns, (double)prof->in_bytes / prof->calls,
+            (double)prof->bytes / prof->calls);
+        if (ril_binder_radio_alloc_count) {
+            g_string_append_printf(out, "%.2f\t%lu\n",
+                (double)prof->allocs / prof->calls, prof->max_allocs);
+        } else {
+            g_string_append(out, "-\t-\n");
+        }
+    }
+    if (g_file_set_contents(path, out->str, out->len, &error)) {
+        GINFO("Profile written to %s", path);
+    } else {
+        GERR("%s", GERRMSG(error));
+        g_error_free(error);
+    }
+    g_string_free(out, TRUE);
+    g_free(path);
+}
+
+#else
+
+typedef struct ril_binder_radio_profile_scope {
+    int unused;
+} RilBinderRadioProfileScope;
+
+#define ril_binder_radio_profile_decoder(self,name) ((void)0)
+#define ril_binder_radio_profile_begin(scope,kind,name) ((void)(scope))
+#define ril_binder_radio_profile_end(scope) ((void)0)
+
+#endif /* RIL_BINDER_PROFILE */
+
+static inline
+gboolean
+ril_binder_radio_run_encoder(
+    RilBinderRadio* self,
+    const RilBinderRadioCall* call,
+    GRilIoRequest* in,
+    GBinderLocalRequest* out)
+{
+    RilBinderRadioEncodeCtx ctx;
+    gboolean ok;
+
+    ctx.pool = self->priv->arena;
+    ctx.arena = NULL;
+#ifdef RIL_BINDER_PROFILE
+    if (call->encode) {
+        RilBinderRadioProfile* prof = ril_binder_radio_profile_get
+            (&ril_binder_radio_profile_encoders, "encode", call->name);
+        const gulong allocs = ril_binder_radio_profile_allocs();
+        const guint64 start = ril_binder_radio_profile_ns();
+        GBinderWriter writer;
+
+        ok = call->encode(in, out, &ctx);
+        gbinder_local_request_init_writer(out, &writer);
+        ril_binder_radio_profile_add(prof, start, allocs,
+            grilio_request_size(in), gbinder_writer_bytes_written(&writer));
+    } else {
+        ok = TRUE;
+    }
+#else
+    ok = !call->encode || call->encode(in, out, &ctx);
+#endif
+    if (ctx.arena) {
+        /* The request references the arena until it's sent */
+        gbinder_local_request_cleanup(out, ril_binder_radio_arena_free,
+            ctx.arena);
+    }
+    return ok;
+}
+
+static inline
+gboolean
+ril_binder_radio_run_decoder(
+    RilBinderRadio* self,
+    RilBinderRadioDecodeFunc decode,
+    GBinderReader* in,
+    GByteArray* out)
+{
+#ifdef RIL_BINDER_PROFILE
+    RilBinderRadioProfile* prof = self->priv->prof_decode;
+
+    if (decode && prof) {
+        const gsize in_start = gbinder_reader_bytes_read(in);
+        const gulong allocs = ril_binder_radio_profile_allocs();
+        const guint64 start = ril_binder_radio_profile_ns();
+        const gboolean ok = decode(in, out);
+
+        ril_binder_radio_profile_add(prof, start, allocs,
+            gbinder_reader_bytes_read(in) - in_start, out->len);
+        return ok;
+    }
+#endif
+    return !decode || decode(in, out);
+}
+
+/*==========================================================================*
+ * Deduplication
+ *==========================================================================*/
+
+static
+guint32
+ril_binder_radio_dedup_hash(
+    const guint8* data,
+    guint len)
+{
+    /* FNV-1a */
+    guint32 h = 2166136261u;
+    guint i;
+
+    for (i = 0; i < len; i++) {
+        h = (h ^ data[i]) * 16777619u;
+    }
+    return h;
+}
+
+/* Returns TRUE if the indication has been suppressed */
+static
+gboolean
+ril_binder_radio_dedup_filter(
+    RilBinderRadio* self,
+    RADIO_IND_TYPE ind_type,
+    guint ril_code,
+    const GByteArray* buf)
+{
+    RilBinderRadioPriv* priv = self->priv;
+    guint i;
+
+    for (i = 0; i < RIL_BINDER_DEDUP_COUNT; i++) {
+        if (ril_binder_radio_dedup_codes[i] == ril_code) {
+            RilBinderRadioDedup* dedup = priv->dedup + i;
+            const gint64 now = g_get_monotonic_time();
+            const guint32 hash = ril_binder_radio_dedup_hash(buf->data,
+                buf->len);
+
+            if (dedup->last && hash == dedup->hash &&
+                now < dedup->time + (gint64)priv->dedup_window * 1000 &&
+                dedup->last->len == buf->len &&
+                !memcmp(dedup->last->data, buf->data, buf->len)) {
+                dedup->suppressed++;
+                DBG_(self, "suppressed duplicate indication %u (%u)",
+                    ril_code, dedup->suppressed);
+                if (ind_type == RADIO_IND_ACK_EXP && self->radio) {
+                    /* Nobody else is going to ack it */
+                    radio_instance_ack(self->radio);
+                }
+                return TRUE;
+            }
+
+            /* Remember what is being delivered */
+            if (!dedup->last) {
+                dedup->last = g_byte_array_sized_new(buf->len);
+            }
+            g_byte_array_set_size(dedup->last, 0);
+            g_byte_array_append(dedup->last, buf->data, buf->len);
+            dedup->hash = hash;
+            dedup->time = now;
+            break;
+        }
+    }
+    return FALSE;
+}
+
+static
+void
+ril_binder_radio_dedup_clear(
+    RilBinderRadio* self)
+{
+    RilBinderRadioPriv* priv = self->priv;
+    guint i;
+
+    for (i = 0; i < RIL_BINDER_DEDUP_COUNT; i++) {
+        RilBinderRadioDedup* dedup = priv->dedup + i;
+
+        if (dedup->suppressed) {
+            GDEBUG("%s%u duplicate(s) of indication %u suppressed",
+                self->parent.log_prefix, dedup->suppressed,
+                ril_binder_radio_dedup_codes[i]);
+        }
+        if (dedup->last) {
+            g_byte_array_unref(dedup->last);
+        }
+        memset(dedup, 0, sizeof(*dedup));
+    }
+}
+
+/*==========================================================================*
+ * APN cache
+ *==========================================================================*/
+
+static
+RilBinderRadioApnCache*
+ril_binder_radio_apn_cache_get(
+    RilBinderRadio* self,
+    guint code)
+{
+    RilBinderRadioPriv* priv = self->priv;
+
+    if (priv->apn_cache) {
+        guint i;
+
+        for (i = 0; i < RIL_BINDER_APN_CACHE_COUNT; i++) {
+            if (ril_binder_radio_apn_cache_codes[i] == code) {
+                return priv->apn + i;
+            }
+        }
+    }
+    return NULL;
+}
+
+/* Returns TRUE if the request is to be completed locally */
+static
+gboolean
+ril_binder_radio_apn_cache_send(
+    RilBinderRadio* self,
+    guint code,
+    GRilIoRequest* req)
+{
+    RilBinderRadioApnCache* cache = ril_binder_radio_apn_cache_get(self, code);
+
+    if (cache) {
+        const guint8* data = grilio_request_data(req);
+        const guint len = grilio_request_size(req);
+        const guint32 hash = ril_binder_radio_dedup_hash(data, len);
+
+        /* Something different may be in flight, then it has to go through */
+        if (!cache->sent && cache->acked && hash == cache->acked_hash &&
+            cache->acked->len == len && !memcmp(cache->acked->data,
+            data, len)) {
+            cache->hits++;
+            DBG_(self, "request %u matches the acknowledged one (%u)",
+                code, cache->hits);
+            return TRUE;
+        }
+
+        /* Remember what is being sent */
+        if (!cache->sent) {
+            cache->sent = g_byte_array_sized_new(len);
+        }
+        g_byte_array_set_size(cache->sent, 0);
+        g_byte_array_append(cache->sent, data, len);
+        cache->sent_hash = hash;
+        cache->sent_serial = grilio_request_serial(req);
+    }
+    return FALSE;
+}
+
+/*
+ * Invoked for each completed request, whether the completion came from
+ * the HAL or the request failed locally.
+ */
+static
+void
+ril_binder_radio_apn_cache_done(
+    RilBinderRadio* self,
+    guint serial,
+    guint status)
+{
+    RilBinderRadioPriv* priv = self->priv;
+    guint i;
+
+    for (i = 0; i < RIL_BINDER_APN_CACHE_COUNT; i++) {
+        RilBinderRadioApnCache* cache = priv->apn + i;
+
+        if (cache->sent && cache->sent_serial == serial) {
+            GByteArray* sent = cache->sent;
+
+            cache->sent = NULL;
+            if (cache->acked) {
+                g_byte_array_unref(cache->acked);
+                cache->acked = NULL;
+            }
+            if (status == RIL_E_SUCCESS) {
+                /* The modem now has this configuration */
+                cache->acked = sent;
+                cache->acked_hash = cache->sent_hash;
+            } else {
+                /* Don't know what the modem has, next one goes through */
+                g_byte_array_unref(sent);
+            }
+            break;
+        }
+    }
+}
+
+/*
+ * The modem may have lost its configuration (radio turned off or became
+ * unavailable, modem reset, SIM change), the next request of each kind
+ * has to go through. Responses to the requests in flight are ignored.
+ */
+static
+void
+ril_binder_radio_apn_cache_invalidate(
+    RilBinderRadio* self)
+{
+    RilBinderRadioPriv* priv = self->priv;
+    guint i;
+
+    for (i = 0; i < RIL_BINDER_APN_CACHE_COUNT; i++) {
+        RilBinderRadioApnCache* cache = priv->apn + i;
+
+        if (cache->acked) {
+            g_byte_array_unref(cache->acked);
+            cache->acked = NULL;
+        }
+        if (cache->sent) {
+            g_byte_array_unref(cache->sent);
+            cache->sent = NULL;
+        }
+    }
+}
+
+static
+void
+ril_binder_radio_apn_cache_indication(
+    RilBinderRadio* self,
+    RADIO_IND code,
+    const GBinderReader* args)
+{
+    if (self->priv->apn_cache) {
+        gboolean invalidate = FALSE;
+
+        if (code == RADIO_IND_RADIO_STATE_CHANGED) {
+            GBinderReader reader;
+            gint32 state;
+
+            /* radioStateChanged(RadioIndicationType, RadioState) */
+            gbinder_reader_copy(&reader, args);
+            invalidate = gbinder_reader_read_int32(&reader, &state) &&
+                (state == RADIO_STATE_OFF || state == RADIO_STATE_UNAVAILABLE);
+        } else {
+            invalidate = (code == RADIO_IND_MODEM_RESET ||
+                code == RADIO_IND_SIM_STATUS_CHANGED);
+        }
+        if (invalidate) {
+            DBG_(self, "indication %u invalidates APN cache", code);
+            ril_binder_radio_apn_cache_invalidate(self);
+        }
+    }
+}
+
+static
+void
+ril_binder_radio_apn_cache_clear(
+    RilBinderRadio* self)
+{
+    RilBinderRadioPriv* priv = self->priv;
+    guint i;
+
+    for (i = 0; i < RIL_BINDER_APN_CACHE_COUNT; i++) {
+        RilBinderRadioApnCache* cache = priv->apn + i;
+
+        if (cache->hits) {
+            GDEBUG("%s%u request(s) %u completed from cache",
+                self->parent.log_prefix, cache->hits,
+                ril_binder_radio_apn_cache_codes[i]);
+        }
+        cache->hits = 0;
+    }
+    ril_binder_radio_apn_cache_invalidate(self);
+}
+
+/*==========================================================================*
+ * Generic failure
+ *==========================================================================*/
+
+static
+void
+ril_binder_radio_generic_failure_run(
+    gpointer data)
+{
+    RilBinderRadio* self = RIL_BINDER_RADIO(data);
+    RilBinderRadioFailures* failures = &self->priv->failures;
+    GRilIoTransport* transport = &self->parent;
+
+    /*
+     * Signal handlers may submit more requests and those may fail too.
+     * Those failures get appended to the ring and completed right here.
+     */
+    grilio_transport_ref(transport);
+    while (failures->count) {
+        const RilBinderRadioCompletion done =
+            failures->entry[failures->first];
+
+        failures->first = (failures->first + 1) % failures->size;
+        failures->count--;
+        grilio_transport_signal_response(transport, GRILIO_RESPONSE_SOLICITED,
+            done.serial, done.status, NULL, 0);
+    }
+    failures->scheduled = FALSE;
+    grilio_transport_unref(transport);
+}
+
+static
+void
+ril_binder_radio_generic_failure_push(
+    RilBinderRadioFailures* failures,
+    guint serial,
+    guint status)
+{
+    RilBinderRadioCompletion* done;
+
+    if (failures->count == failures->size) {
+        /* Grow the ring, keeping the pending entries in order */
+        const guint size = MAX(failures->size * 2,
+            RIL_BINDER_FAILURES_INITIAL_SIZE);
+        RilBinderRadioCompletion* entries =
+            g_new(RilBinderRadioCompletion, size);
+        guint i;
+
+        for (i = 0; i < failures->count; i++) {
+            entries[i] = failures->entry[(failures->first + i) %
+                failures->size];
+        }
+        g_free(failures->entry);
+        failures->entry = entries;
+        failures->size = size;
+        failures->first = 0;
+    }
+    done = failures->entry + (failures->first + failures->count) %
+        failures->size;
+    done->serial = serial;
+    done->status = status;
+    failures->count++;
+}
+
+/* Completes the request on the next idle loop iteration */
+static
+void
+ril_binder_radio_complete_locally(
+    RilBinderRadio* self,
+    guint serial,
+    guint status)
+{
+    RilBinderRadioPriv* priv = self->priv;
+    RilBinderRadioFailures* failures = &priv->failures;
+
+    ril_binder_radio_generic_failure_push(failures, serial, status);
+    if (!failures->scheduled) {
+        failures->scheduled = TRUE;
+        gutil_idle_queue_add(priv->idle,
+            ril_binder_radio_generic_failure_run, self);
+    }
+}
+
+static
+GRILIO_SEND_STATUS
+ril_binder_radio_generic_failure(
+    RilBinderRadio* self,
+    GRilIoRequest* req)
+{
+    if (self->radio) {
+        RilBinderRadioPriv* priv = self->priv;
+        const guint serial = grilio_request_serial(req);
+
+        /* This one is not going to be completed by the HAL */
+        RIL_BINDER_TRACE1(generic_failure, serial);
+        ril_binder_recorder_add(priv->recorder, RIL_BINDER_RECORD_FAILURE,
+            0, serial, RIL_E_GENERIC_FAILURE, 0);
+        ril_binder_radio_latency_cancel(self, serial);
+        ril_binder_radio_apn_cache_done(self, serial, RIL_E_GENERIC_FAILURE);
+        ril_binder_radio_complete_locally(self, serial, RIL_E_GENERIC_FAILURE);
+        return GRILIO_SEND_OK;
+    }
+    return GRILIO_SEND_ERROR;
+}
+
+/*==========================================================================*
+ * Asynchronous submission
+ *
+ * In async mode encoded requests are handed over to a single worker
+ * thread (which preserves the order of requests) so that a slow HAL
+ * doesn't block the main loop. The result of each transaction is then
+ * reported back to the main thread.
+ *==========================================================================*/
+
+static
+gboolean
+ril_binder_radio_tx_complete(
+    gpointer data)
+{
+    RilBinderRadioTx* tx = data;
+    RilBinderRadio* self = tx->self;
+    RilBinderRadioPriv* priv = self->priv;
+    GRilIoTransport* transport = &self->parent;
+    guint i;
+
+    GASSERT(priv->queued >= tx->count);
+    priv->queued -= tx->count;
+    for (i = 0; i < tx->count; i++) {
+        const RilBinderRadioTxEntry* entry = tx->entry + i;
+
+        if (!entry->ok) {
+            GWARN("%s%s() transaction failed", transport->log_prefix,
+                entry->call->name);
+            ril_binder_radio_apn_cache_done(self, entry->serial,
+                RIL_E_GENERIC_FAILURE);
+            if (self->radio) {
+                /* All kinds of failures map to RIL_E_GENERIC_FAILURE */
+                grilio_transport_signal_response(transport,
+                    GRILIO_RESPONSE_SOLICITED, entry->serial,
+                    RIL_E_GENERIC_FAILURE, NULL, 0);
+            }
+        }
+    }
+    return G_SOURCE_REMOVE;
+}
+
+static
+void
+ril_binder_radio_tx_free(
+    gpointer data)
+{
+    RilBinderRadioTx* tx = data;
+    guint i;
+
+    for (i = 0; i < tx->count; i++) {
+        gbinder_local_request_unref(tx->entry[i].txreq);
+    }
+    radio_instance_unref(tx->radio);
+    g_object_unref(tx->self);
+    g_free(tx);
+}
+
+static
+void
+ril_binder_radio_tx_proc(
+    gpointer data,
+    gpointer user_data)
+{
+    RilBinderRadioTx* tx = data;
+    guint i;
+
+    /* This runs on the worker thread */
+    for (i = 0; i < tx->count; i++) {
+        RilBinderRadioTxEntry* entry = tx->entry + i;
+
+        entry->ok = radio_instance_send_request_sync(tx->radio,
+            entry->call->req_tx, entry->txreq);
+    }
+    g_main_context_invoke_full(tx->self->priv->context, G_PRIORITY_DEFAULT,
+        ril_binder_radio_tx_complete, tx, ril_binder_radio_tx_free);
+}
+
+static
+RilBinderRadioTx*
+ril_binder_radio_tx_new(
+    RilBinderRadio* self,
+    guint max_count)
+{
+    RilBinderRadioTx* tx = g_malloc(G_STRUCT_OFFSET(RilBinderRadioTx, entry) +
+        sizeof(RilBinderRadioTxEntry) * MAX(max_count, 1));
+
+    tx->self = g_object_ref(self);
+    tx->radio = radio_instance_ref(self->radio);
+    tx->count = 0;
+    return tx;
+}
+
+static
+void
+ril_binder_radio_tx_add(
+    RilBinderRadioTx* tx,
+    const RilBinderRadioCall* call,
+    GBinderLocalRequest* txreq,
+    guint serial)
+{
+    RilBinderRadioTxEntry* entry = tx->entry + (tx->count++);
+
+    entry->call = call;
+    entry->txreq = gbinder_local_request_ref(txreq);
+    entry->serial = serial;
+    entry->ok = FALSE;
+}
+
+static
+gboolean
+ril_binder_radio_tx_push(
+    RilBinderRadio* self,
+    RilBinderRadioTx* tx)
+{
+    RilBinderRadioPriv* priv = self->priv;
+    GError* error = NULL;
+    const guint count = tx->count;
+
+    if (g_thread_pool_push(priv->pool, tx, &error)) {
+        priv->queued += count;
+        return TRUE;
+    }
+    GERR("%s%s", self->parent.log_prefix, GERRMSG(error));
+    g_error_free(error);
+    ril_binder_radio_tx_free(tx);
+    return FALSE;
+}
+
+static
+gboolean
+ril_binder_radio_tx_submit(
+    RilBinderRadio* self,
+    const RilBinderRadioCall* call,
+    GBinderLocalRequest* txreq,
+    guint serial)
+{
+    RilBinderRadioPriv* priv = self->priv;
+
+    if (priv->queued < priv->queue_size) {
+        RilBinderRadioTx* tx = ril_binder_radio_tx_new(self, 1);
+
+        ril_binder_radio_tx_add(tx, call, txreq, serial);
+        return ril_binder_radio_tx_push(self, tx);
+    } else {
+        GWARN("%s%s() rejected, %u requests queued", self->parent.log_prefix,
+            call->name, priv->queued);
+        return FALSE;
+    }
+}
+
+/*==========================================================================*
+ * Batching
+ *
+ * In batch mode requests submitted during one main loop iteration are
+ * collected and then encoded and submitted back-to-back by a single
+ * idle callback. The batch array is reused between flushes.
+ *==========================================================================*/
+
+static
+GBinderLocalRequest*
+ril_binder_radio_template_request(
+    RilBinderRadio* self,
+    const RilBinderRadioCall* call,
+    guint serial)
+{
+    RilBinderRadioPriv* priv = self->priv;
+    RilBinderRadioTemplate* tmpl;
+    GBinderWriter writer;
+
+    if (!priv->templates) {
+        priv->templates = g_new0(RilBinderRadioTemplate,
+            priv->tables->req_count);
+    }
+
+    tmpl = priv->templates + call->code;
+    if (tmpl->req) {
+        /* Only the serial needs to be updated */
+        gbinder_local_request_init_writer(tmpl->req, &writer);
+        gbinder_writer_overwrite_int32(&writer, tmpl->serial_offset, serial);
+    } else {
+        tmpl->req = radio_instance_new_request(self->radio, call->req_tx);
+        gbinder_local_request_init_writer(tmpl->req, &writer);
+        tmpl->serial_offset = gbinder_writer_bytes_written(&writer);
+        gbinder_writer_append_int32(&writer, serial);
+    }
+    return gbinder_local_request_ref(tmpl->req);
+}
+
+static
+GBinderLocalRequest*
+ril_binder_radio_encode(
+    RilBinderRadio* self,
+    const RilBinderRadioCall* call,
+    GRilIoRequest* req)
+{
+    GBinderLocalRequest* txreq;
+
+    /*
+     * Requests without arguments other than the serial are created once
+     * and then reused. That's only safe when they are sent synchronously,
+     * otherwise the previous one may still be in the async queue.
+     */
+    if (call->encode == ril_binder_radio_encode_serial && !self->priv->pool) {
+        return ril_binder_radio_template_request(self, call,
+            grilio_request_serial(req));
+    }
+
+    txreq = radio_instance_new_request(self->radio, call->req_tx);
+    if (ril_binder_radio_run_encoder(self, call, req, txreq)) {
+        return txreq;
+    }
+    GWARN("Failed to encode %s() arguments", call->name);
+    gbinder_local_request_unref(txreq);
+    return NULL;
+}
+
+static
+void
+ril_binder_radio_batch_log(
+    RilBinderRadio* self,
+    int level)
+{
+    const guint* h = self->priv->batch_hist;
+
+    gutil_log(GLOG_MODULE_CURRENT, level, "%sbatch sizes 1:%u 2:%u 3-4:%u "
+        "5-8:%u 9-16:%u 17-32:%u 33+:%u", self->parent.log_prefix,
+        h[0], h[1], h[2], h[3], h[4], h[5], h[6]);
+}
+
+static
+void
+ril_binder_radio_batch_account(
+    RilBinderRadio* self,
+    guint count)
+{
+    RilBinderRadioPriv* priv = self->priv;
+    guint i = 0, limit = 1;
+
+    while (count > limit && i < (RIL_BINDER_BATCH_HIST_SIZE - 1)) {
+        limit <<= 1;
+        i++;
+    }
+    priv->batch_hist[i]++;
+    if (!(++priv->batch_flushes % RIL_BINDER_BATCH_LOG_INTERVAL)) {
+        ril_binder_radio_batch_log(self, GLOG_LEVEL_DEBUG);
+    }
+}
+
+static
+void
+ril_binder_radio_batch_clear(
+    RilBinderRadio* self)
+{
+    RilBinderRadioPriv* priv = self->priv;
+    guint i;
+
+    for (i = 0; i < priv->batch_count; i++) {
+        grilio_request_unref(priv->batch[i].req);
+    }
+    priv->batch_count = 0;
+    if (priv->batch_flush_id) {
+        g_source_remove(priv->batch_flush_id);
+        priv->batch_flush_id = 0;
+    }
+}
+
+static
+void
+ril_binder_radio_batch_flush(
+    RilBinderRadio* self)
+{
+    RilBinderRadioPriv* priv = self->priv;
+    const guint count = priv->batch_count;
+
+    if (count && self->radio) {
+        RilBinderRadioTx* tx = NULL;
+        guint i, capacity = 0;
+
+        if (priv->pool) {
+            capacity = priv->queue_size - MIN(priv->queued, priv->queue_size);
+            if (capacity) {
+                tx = ril_binder_radio_tx_new(self, MIN(count, capacity));
+            }
+        }
+
+        GVERBOSE("%sflushing %u request(s)", self->parent.log_prefix, count);
+        for (i = 0; i < count; i++) {
+            const RilBinderRadioBatchEntry* entry = priv->batch + i;
+            const RilBinderRadioCall* call = entry->call;
+            GRilIoRequest* req = entry->req;
+            gboolean ok = FALSE;
+
+            if (priv->pool && (!tx || tx->count >= capacity)) {
+                GWARN("%s%s() rejected, %u requests queued",
+                    self->parent.log_prefix, call->name, priv->queued +
+                    (tx ? tx->count : 0));
+            } else {
+                GBinderLocalRequest* txreq = ril_binder_radio_encode(self,
+                    call, req);
+
+                if (txreq) {
+                    if (tx) {
+                        ril_binder_radio_tx_add(tx, call, txreq,
+                            grilio_request_serial(req));
+                        ok = TRUE;
+                    } else {
+                        ok = radio_instance_send_request_sync(self->radio,
+                            call->req_tx, txreq);
+                    }
+                    gbinder_local_request_unref(txreq);
+                }
+            }
+            if (!ok) {
+                ril_binder_radio_generic_failure(self, req);
+            }
+        }
+
+        if (tx) {
+            if (tx->count) {
+                ril_binder_radio_tx_push(self, tx);
+            } else {
+                ril_binder_radio_tx_free(tx);
+            }
+        }
+        ril_binder_radio_batch_account(self, count);
+    }
+    ril_binder_radio_batch_clear(self);
+}
+
+static
+gboolean
+ril_binder_radio_batch_flush_cb(
+    gpointer user_data)
+{
+    RilBinderRadio* self = RIL_BINDER_RADIO(user_data);
+
+    self->priv->batch_flush_id = 0;
+    ril_binder_radio_batch_flush(self);
+    return G_SOURCE_REMOVE;
+}
+
+static
+void
+ril_binder_radio_batch_add(
+    RilBinderRadio* self,
+    const RilBinderRadioCall* call,
+    GRilIoRequest* req)
+{
+    RilBinderRadioPriv* priv = self->priv;
+    RilBinderRadioBatchEntry* entry;
+
+    if (priv->batch_count == priv->batch_alloc) {
+        priv->batch_alloc = MAX(priv->batch_alloc * 2, 8);
+        priv->batch = g_renew(RilBinderRadioBatchEntry, priv->batch,
+            priv->batch_alloc);
+    }
+    entry = priv->batch + (priv->batch_count++);
+    entry->call = call;
+    entry->req = grilio_request_ref(req);
+    if (!priv->batch_flush_id) {
+        /*
+         * Idle priority would let a steady stream of default priority
+         * events (binder, D-Bus) hold the batch back indefinitely. At
+         * default priority the flush runs in the next main loop iteration,
+         * after the sources which were already dispatched in this one.
+         */
+        priv->batch_flush_id = g_idle_add_full(G_PRIORITY_DEFAULT,
+            ril_binder_radio_batch_flush_cb, self, NULL);
+    }
+}
+
+/*==========================================================================*
+ * Signal strength coalescing
+ *==========================================================================*/
+
+static
+gboolean
+ril_binder_radio_signal_value_changed(
+    gint32 v1,
+    gint32 v2,
+    gint32 unknown,
+    int delta)
+{
+    if (v1 == v2) {
+        return FALSE;
+    } else if ((v1 == unknown) || (v2 == unknown)) {
+        /* Signal has appeared or disappeared */
+        return TRUE;
+    } else {
+        return ABS(v1 - v2) >= delta;
+    }
+}
+
+static
+gboolean
+ril_binder_radio_signal_changed(
+    const RilBinderRadioSignalFilter* filter,
+    const gint32* v1,
+    const gint32* v2)
+{
+    /* ASU steps are 2 dBm each */
+    const int asu_delta = MAX((filter->dbm_delta + 1) / 2, 1);
+
+    /* Indices match ril_binder_radio_decode_signal_strength_common() */
+    return
+        /* GW signalStrength (ASU) */
+        ril_binder_radio_signal_value_changed(v1[0], v2[0], 99, asu_delta) ||
+        /* CDMA dbm */
+        ril_binder_radio_signal_value_changed(v1[2], v2[2],
+            RADIO_CELL_INVALID_VALUE, filter->dbm_delta) ||
+        /* EVDO dbm */
+        ril_binder_radio_signal_value_changed(v1[4], v2[4],
+            RADIO_CELL_INVALID_VALUE, filter->dbm_delta) ||
+        /* LTE signalStrength (ASU) */
+        ril_binder_radio_signal_value_changed(v1[7], v2[7], 99, asu_delta) ||
+        /* LTE rsrp */
+        ril_binder_radio_signal_value_changed(v1[8], v2[8],
+            RADIO_CELL_INVALID_VALUE, filter->rsrp_delta) ||
+        /* LTE rsrq */
+        ril_binder_radio_signal_value_changed(v1[9], v2[9],
+            RADIO_CELL_INVALID_VALUE, filter->rsrq_delta) ||
+        /* TD-SCDMA rscp */
+        ril_binder_radio_signal_value_changed(v1[13], v2[13],
+            RADIO_CELL_INVALID_VALUE, filter->dbm_delta);
+}
+
+static
+void
+ril_binder_radio_signal_cancel(
+    RilBinderRadioSignalFilter* filter)
+{
+    if (filter->timer_id) {
+        g_source_remove(filter->timer_id);
+        filter->timer_id = 0;
+    }
+    filter->pending = FALSE;
+    filter->pending_significant = FALSE;
+}
+
+static
+gboolean
+ril_binder_radio_signal_timeout(
+    gpointer user_data)
+{
+    RilBinderRadio* self = RIL_BINDER_RADIO(user_data);
+    RilBinderRadioSignalFilter* filter = &self->priv->signal;
+    GRilIoTransport* transport = &self->parent;
+
+    filter->timer_id = 0;
+    if (filter->pending) {
+        filter->pending = FALSE;
+        filter->pending_significant = FALSE;
+        if (memcmp(filter->last, filter->next, sizeof(filter->last))) {
+            memcpy(filter->last, filter->next, sizeof(filter->last));
+            filter->last_time = g_get_monotonic_time();
+            DBG_(self, "forwarding coalesced signal strength");
+            grilio_transport_ref(transport);
+            grilio_transport_signal_indication(transport,
+                GRILIO_INDICATION_UNSOLICITED, RIL_UNSOL_SIGNAL_STRENGTH,
+                filter->last, sizeof(filter->last));
+            grilio_transport_unref(transport);
+        }
+    }
+    return G_SOURCE_REMOVE;
+}
+
+static
+void
+ril_binder_radio_signal_schedule(
+    RilBinderRadio* self,
+    guint ms)
+{
+    RilBinderRadioSignalFilter* filter = &self->priv->signal;
+
+    if (filter->timer_id) {
+        g_source_remove(filter->timer_id);
+    }
+    filter->timer_id = g_timeout_add(ms, ril_binder_radio_signal_timeout,
+        self);
+}
+
+/* Returns TRUE if the indication has been consumed by the filter */
+static
+gboolean
+ril_binder_radio_signal_filter(
+    RilBinderRadio* self,
+    RADIO_IND_TYPE ind_type,
+    const GByteArray* buf)
+{
+    RilBinderRadioSignalFilter* filter = &self->priv->signal;
+    const gint32* values = (const gint32*)buf->data;
+    const gint64 now = g_get_monotonic_time();
+    const gint64 next_time = filter->last_time +
+        (gint64)filter->interval * 1000;
+    gboolean significant;
+
+    if (buf->len != sizeof(filter->last)) {
+        /* Not something we understand */
+        return FALSE;
     }
-    return GRILIO_SEND_ERROR;
+
+    significant = !filter->have_last ||
+        ril_binder_radio_signal_changed(filter, filter->last, values);
+    if (significant && now >= next_time) {
+        /* Let this one through */
+        ril_binder_radio_signal_cancel(filter);
+        memcpy(filter->last, values, sizeof(filter->last));
+        filter->have_last = TRUE;
+        filter->last_time = now;
+        return FALSE;
+    }
+
+    /* Hold it back */
+    memcpy(filter->next, values, sizeof(filter->next));
+    filter->pending = TRUE;
+    if (significant) {
+        if (!filter->pending_significant) {
+            filter->pending_significant = TRUE;
+            ril_binder_radio_signal_schedule(self,
+                (guint)((next_time - now + 999) / 1000));
+        }
+    } else if (!filter->pending_significant) {
+        /* Quiet period */
+        ril_binder_radio_signal_schedule(self, filter->interval);
+    }
+
+    if (ind_type == RADIO_IND_ACK_EXP && self->radio) {
+        /* Nobody else is going to ack it */
+        radio_instance_ack(self->radio);
+    }
+    return TRUE;
 }
 
 /*==========================================================================*
@@ -4234,6 +6201,18 @@ ril_binder_radio_drop_radio(
 {
     RilBinderRadioPriv* priv = self->priv;
 
+    if (priv->templates) {
+        const guint n = priv->tables->req_count;
+        guint i;
+
+        for (i = 0; i < n; i++) {
+            gbinder_local_request_unref(priv->templates[i].req);
+        }
+        g_free(priv->templates);
+        priv->templates = NULL;
+    }
+    ril_binder_radio_signal_cancel(&priv->signal);
+    ril_binder_radio_apn_cache_clear(self);
     if (self->radio) {
         radio_instance_remove_all_handlers(self->radio, priv->radio_event_id);
         radio_instance_unref(self->radio);
@@ -4256,7 +6235,12 @@ ril_binder_radio_handle_known_response(
     const RadioResponseInfo* info,
     GBinderReader* reader)
 {
-    if (ril_binder_radio_decode_response(self, info, call->decode, reader)) {
+    gboolean ok;
+
+    ril_binder_radio_profile_decoder(self, call->name);
+    ok = ril_binder_radio_decode_response(self, info, call->decode, reader);
+    ril_binder_radio_profile_decoder(self, NULL);
+    if (ok) {
         return TRUE;
     } else {
         GWARN("Failed to decode %s response", call->name);
@@ -4272,8 +6256,13 @@ ril_binder_radio_handle_known_indication(
     RADIO_IND_TYPE ind_type,
     GBinderReader* reader)
 {
-    if (ril_binder_radio_decode_indication(self, ind_type, event->code,
-        event->decode, reader)) {
+    gboolean ok;
+
+    ril_binder_radio_profile_decoder(self, event->name);
+    ok = ril_binder_radio_decode_indication(self, ind_type, event->code,
+        event->decode, reader);
+    ril_binder_radio_profile_decoder(self, NULL);
+    if (ok) {
         return TRUE;
     } else {
         GWARN("Failed to decode %s indication", event->name);
@@ -4306,8 +6295,21 @@ ril_binder_radio_indication_handler(
 {
     RilBinderRadio* self = RIL_BINDER_RADIO(user_data);
     RilBinderRadioClass* klass = RIL_BINDER_RADIO_GET_CLASS(self);
+    RilBinderRadioPriv* priv = self->priv;
+    gboolean handled;
 
-    return klass->handle_indication(self, code, type, args);
+    if (RIL_BINDER_TRACE_ENABLED(indication)) {
+        RIL_BINDER_TRACE3(indication, code, type,
+            gbinder_reader_bytes_remaining(args));
+    }
+    ril_binder_recorder_add(priv->recorder, RIL_BINDER_RECORD_INDICATION,
+        code, 0, 0, gbinder_reader_bytes_remaining(args));
+    priv->ind_current = ril_binder_radio_ind_counters(self, code);
+    ril_binder_radio_ind_count(priv->ind_current);
+    ril_binder_radio_apn_cache_indication(self, code, args);
+    handled = klass->handle_indication(self, code, type, args);
+    priv->ind_current = NULL;
+    return handled;
 }
 
 static
@@ -4321,8 +6323,24 @@ ril_binder_radio_response_handler(
 {
     RilBinderRadio* self = RIL_BINDER_RADIO(user_data);
     RilBinderRadioClass* klass = RIL_BINDER_RADIO_GET_CLASS(self);
+    RilBinderRadioPriv* priv = self->priv;
+    gboolean handled;
 
-    return klass->handle_response(self, code, info, args);
+    if (RIL_BINDER_TRACE_ENABLED(response)) {
+        RIL_BINDER_TRACE4(response, code, info->serial, info->error,
+            gbinder_reader_bytes_remaining(args));
+    }
+    ril_binder_recorder_add(priv->recorder, RIL_BINDER_RECORD_RESPONSE,
+        code, info->serial, info->error, gbinder_reader_bytes_remaining(args));
+    if (info->type == RADIO_RESP_SOLICITED ||
+        info->type == RADIO_RESP_SOLICITED_ACK_EXP) {
+        ril_binder_radio_latency_finish(self, info->serial);
+        ril_binder_radio_apn_cache_done(self, info->serial, info->error);
+    }
+    priv->resp_current = code;
+    handled = klass->handle_response(self, code, info, args);
+    priv->resp_current = RADIO_RESP_NONE;
+    return handled;
 }
 
 static
@@ -4333,8 +6351,14 @@ ril_binder_radio_ack_handler(
     gpointer user_data)
 {
     RilBinderRadio* self = RIL_BINDER_RADIO(user_data);
+    RilBinderRadioProfileScope scope;
 
     DBG_(self, "IRadioResponse acknowledgeRequest");
+    ril_binder_radio_profile_begin(&scope, "ack", "acknowledgeRequest");
+    ril_binder_recorder_add(self->priv->recorder, RIL_BINDER_RECORD_ACK,
+        0, serial, 0, 0);
+    ril_binder_radio_latency_ack(self, serial);
+    ril_binder_radio_profile_end(&scope);
     grilio_transport_signal_response(&self->parent,
         GRILIO_RESPONSE_SOLICITED_ACK, serial, RIL_E_SUCCESS, NULL, 0);
 }
@@ -4349,6 +6373,9 @@ ril_binder_radio_radio_died(
     GRilIoTransport* transport = &self->parent;
 
     GERR("%sradio died", transport->log_prefix);
+    ril_binder_recorder_add(self->priv->recorder, RIL_BINDER_RECORD_DEATH,
+        0, 0, 0, 0);
+    ril_binder_recorder_dump(self->priv->recorder, "radio died");
     ril_binder_radio_drop_radio(self);
     grilio_transport_signal_disconnected(transport);
 }
@@ -4393,6 +6420,10 @@ ril_binder_radio_handle_oemhook_raw_response(
     GRILIO_RESPONSE_TYPE type = ril_binder_radio_convert_resp_type(info->type);
 
     if (type != GRILIO_RESPONSE_NONE) {
+        if (type != GRILIO_RESPONSE_SOLICITED_ACK) {
+            ril_binder_radio_latency_finish(RIL_BINDER_RADIO(user_data),
+                info->serial);
+        }
         grilio_transport_signal_response(GRILIO_TRANSPORT(user_data), type,
             info->serial, info->error, data->bytes, data->size);
     }
@@ -4410,17 +6441,8 @@ ril_binder_radio_handle_response(
     const RadioResponseInfo* info,
     const GBinderReader* args)
 {
-    RilBinderRadioPriv* priv = self->priv;
-    int i = MIN(self->radio->version, RADIO_INTERFACE_COUNT - 1);
-    const RilBinderRadioCall* call = NULL;
-
-    while (i >= 0 && !call) {
-        GHashTable* map = priv->resp_map[i--];
-
-        if (map) {
-            call = g_hash_table_lookup(map, GINT_TO_POINTER(code));
-        }
-    }
+    const RilBinderRadioCall* call =
+        ril_binder_radio_tables_resp(self->priv->tables, code);
 
     if (call) {
         GBinderReader copy;
@@ -4450,17 +6472,8 @@ ril_binder_radio_handle_indication(
         ril_binder_radio_connected(self);
         return TRUE;
     } else {
-        RilBinderRadioPriv* priv = self->priv;
-        int i = MIN(self->radio->version, RADIO_INTERFACE_COUNT - 1);
-        const RilBinderRadioEvent* event = NULL;
-
-        while (i >= 0 && !event) {
-            GHashTable* map = priv->unsol_map[i--];
-
-            if (map) {
-                event = g_hash_table_lookup(map, GINT_TO_POINTER(code));
-            }
-        }
+        const RilBinderRadioEvent* event =
+            ril_binder_radio_tables_unsol(self->priv->tables, code);
 
         if (event) {
             GBinderReader reader;
@@ -4477,7 +6490,12 @@ ril_binder_radio_handle_indication(
             return ril_binder_radio_handle_known_indication(self, event,
                 type, &reader);
         } else {
+            RilBinderRadioIndCounters* ind = self->priv->ind_current;
+
             DBG_(self, "IRadioIndication %u", code);
+            if (ind) {
+                ind->unknown++;
+            }
             return FALSE;
         }
     }
@@ -4492,39 +6510,54 @@ ril_binder_radio_send(
 {
     RilBinderRadio* self = RIL_BINDER_RADIO(transport);
     RilBinderRadioPriv* priv = self->priv;
-    int i = MIN(self->radio->version, RADIO_INTERFACE_COUNT - 1);
-    const RilBinderRadioCall* call = NULL;
-
-    while (i >= 0 && !call) {
-        GHashTable* map = priv->req_map[i--];
+    const RilBinderRadioCall* call =
+        ril_binder_radio_tables_req(priv->tables, code);
 
-        if (map) {
-            call = g_hash_table_lookup(map, GINT_TO_POINTER(code));
-        }
+    if (RIL_BINDER_TRACE_ENABLED(send)) {
+        RIL_BINDER_TRACE3(send, code, grilio_request_serial(req),
+            grilio_request_size(req));
     }
-
+    ril_binder_recorder_add(priv->recorder, RIL_BINDER_RECORD_REQUEST,
+        call ? call->req_tx : code, grilio_request_serial(req), 0,
+        grilio_request_size(req));
     if (call) {
         /* This is a known request */
-        GBinderLocalRequest* txreq = radio_instance_new_request(self->radio,
-            call->req_tx);
+        if (ril_binder_radio_apn_cache_send(self, code, req)) {
+            ril_binder_radio_complete_locally(self,
+                grilio_request_serial(req), RIL_E_SUCCESS);
+            return GRILIO_SEND_OK;
+        }
+        ril_binder_radio_latency_start(self, call->name,
+            grilio_request_serial(req));
+        if (priv->batch_mode) {
+            ril_binder_radio_batch_add(self, call, req);
+            return GRILIO_SEND_OK;
+        } else {
+            GBinderLocalRequest* txreq = ril_binder_radio_encode(self, call,
+                req);
+
+            if (txreq) {
+                const gboolean ok = priv->pool ?
+                    ril_binder_radio_tx_submit(self, call, txreq,
+                        grilio_request_serial(req)) :
+                    radio_instance_send_request_sync(self->radio,
+                        call->req_tx, txreq);
 
-        if (!call->encode || call->encode(req, txreq)) {
-            if (radio_instance_send_request_sync(self->radio, call->req_tx,
-                txreq)) {
-                /* Transaction succeeded */
                 gbinder_local_request_unref(txreq);
-                return GRILIO_SEND_OK;
+                if (ok) {
+                    /* Transaction succeeded (or has been queued) */
+                    return GRILIO_SEND_OK;
+                }
             }
-        } else {
-            GWARN("Failed to encode %s() arguments", call->name);
         }
-        gbinder_local_request_unref(txreq);
     } else if (code == RIL_REQUEST_OEM_HOOK_RAW) {
         /*
          * This needs to be special-cased, because OEM_HOOK functionality
          * was moved to separate IOemHook interface.
          */
         if (priv->oemhook) {
+            ril_binder_radio_latency_start(self, RIL_BINDER_OEM_HOOK_RAW_NAME,
+                grilio_request_serial(req));
             if (ril_binder_oemhook_send_request_raw(priv->oemhook, req)) {
                 return GRILIO_SEND_OK;
             }
@@ -4548,6 +6581,11 @@ ril_binder_radio_shutdown(
     RilBinderRadio* self = RIL_BINDER_RADIO(transport);
     const gboolean was_connected = (self->radio != NULL);
 
+    if (flush) {
+        ril_binder_radio_batch_flush(self);
+    } else {
+        ril_binder_radio_batch_clear(self);
+    }
     ril_binder_radio_drop_radio(self);
     if (was_connected) {
         grilio_transport_signal_disconnected(transport);
@@ -4580,6 +6618,100 @@ ril_binder_radio_set_channel(
     }
 }
 
+/*==========================================================================*
+ * Output buffers
+ *==========================================================================*/
+
+static
+RilBinderRadioBuf*
+ril_binder_radio_buf_new(
+    RilBinderRadio* self)
+{
+    RilBinderRadioBuf* buf = g_slice_new(RilBinderRadioBuf);
+
+    buf->bytes = g_byte_array_sized_new(RIL_BINDER_BUF_SMALL_SIZE);
+    buf->peak = 0;
+    buf->charged = sizeof(*buf) + RIL_BINDER_BUF_SMALL_SIZE;
+    ril_binder_radio_mem_charge(self->priv->mem, buf->charged);
+    return buf;
+}
+
+static
+void
+ril_binder_radio_buf_free(
+    RilBinderRadio* self,
+    RilBinderRadioBuf* buf)
+{
+    ril_binder_radio_mem_uncharge(self->priv->mem, buf->charged);
+    g_byte_array_unref(buf->bytes);
+    g_slice_free(RilBinderRadioBuf, buf);
+}
+
+static
+int
+ril_binder_radio_buf_class(
+    gsize size)
+{
+    return (size <= RIL_BINDER_BUF_SMALL_SIZE) ? RIL_BINDER_BUF_SMALL :
+        (size <= RIL_BINDER_BUF_MEDIUM_SIZE) ? RIL_BINDER_BUF_MEDIUM :
+        RIL_BINDER_BUF_LARGE;
+}
+
+static
+RilBinderRadioBuf*
+ril_binder_radio_buf_acquire(
+    RilBinderRadio* self,
+    int c)
+{
+    RilBinderRadioPriv* priv = self->priv;
+    int i;
+
+    /*
+     * The requested class first, then larger ones. Smaller buffers are
+     * the last resort, they will have to grow.
+     */
+    for (i = c; i < RIL_BINDER_BUF_CLASS_COUNT; i++) {
+        if (priv->buf_count[i]) {
+            return priv->buf[i][--priv->buf_count[i]];
+        }
+    }
+    for (i = c - 1; i >= 0; i--) {
+        if (priv->buf_count[i]) {
+            return priv->buf[i][--priv->buf_count[i]];
+        }
+    }
+    return ril_binder_radio_buf_new(self);
+}
+
+static
+void
+ril_binder_radio_buf_release(
+    RilBinderRadio* self,
+    RilBinderRadioBuf* buf)
+{
+    RilBinderRadioPriv* priv = self->priv;
+
+    buf->peak = MAX(buf->peak, buf->bytes->len);
+    if (buf->charged < sizeof(*buf) + buf->peak) {
+        /* The array has grown (approximately, it rounds up) */
+        ril_binder_radio_mem_charge(priv->mem, sizeof(*buf) + buf->peak -
+            buf->charged);
+        buf->charged = sizeof(*buf) + buf->peak;
+    }
+    if (buf->peak <= priv->buf_trim) {
+        const int c = ril_binder_radio_buf_class(buf->peak);
+
+        if (priv->buf_count[c] < RIL_BINDER_BUF_PER_CLASS) {
+            g_byte_array_set_size(buf->bytes, 0);
+            priv->buf[c][priv->buf_count[c]++] = buf;
+            return;
+        }
+    } else {
+        DBG_(self, "dropping %u byte buffer", buf->peak);
+    }
+    ril_binder_radio_buf_free(self, buf);
+}
+
 /*==========================================================================*
  * API
  *==========================================================================*/
@@ -4610,19 +6742,29 @@ ril_binder_radio_decode_response(
     GBinderReader* reader)
 {
     RilBinderRadioPriv* priv = self->priv;
-    GByteArray* buf = priv->buf;
+    const guint n = priv->tables ? priv->tables->resp_count : 0;
+    const guint code = priv->resp_current;
+    RilBinderRadioBuf* pooled;
+    GByteArray* buf;
     gboolean signaled = FALSE;
+    gboolean ok;
 
-    /* Protection against hypothetical recursion */
-    if (buf) {
-        priv->buf = NULL;
-    } else {
-        buf = g_byte_array_new();
+    if (code && code < n && !priv->resp_buf_class) {
+        /* Zero is RIL_BINDER_BUF_SMALL */
+        priv->resp_buf_class = g_new0(guint8, n);
     }
+    pooled = ril_binder_radio_buf_acquire(self, (code && code < n) ?
+        priv->resp_buf_class[code] : RIL_BINDER_BUF_SMALL);
+    buf = pooled->bytes;
 
     /* Decode the response */
-    g_byte_array_set_size(buf, 0);
-    if (!decode || decode(reader, buf)) {
+    ok = ril_binder_radio_run_decoder(self, decode, reader, buf);
+    RIL_BINDER_TRACE5(decode_response, code, info->serial, info->error, ok,
+        buf->len);
+    if (code && code < n) {
+        priv->resp_buf_class[code] = ril_binder_radio_buf_class(buf->len);
+    }
+    if (ok) {
         GRilIoTransport* transport = &self->parent;
         GRILIO_RESPONSE_TYPE type = ril_binder_radio_convert_resp_type
             (info->type);
@@ -4634,11 +6776,7 @@ ril_binder_radio_decode_response(
         }
     }
 
-    g_byte_array_set_size(buf, 0);
-    if (priv->buf) {
-        g_byte_array_unref(priv->buf);
-    }
-    priv->buf = buf;
+    ril_binder_radio_buf_release(self, pooled);
     return signaled;
 }
 
@@ -4650,37 +6788,321 @@ ril_binder_radio_decode_indication(
     RilBinderRadioDecodeFunc decode,
     GBinderReader* reader)
 {
-    RilBinderRadioPriv* priv = self->priv;
-    GByteArray* buf = priv->buf;
+    const RilBinderRadioIndCounters* ind = self->priv->ind_current;
+    /* Average size of this indication, the current one is counted */
+    RilBinderRadioBuf* pooled = ril_binder_radio_buf_acquire(self,
+        ril_binder_radio_buf_class((ind && ind->count > 1) ?
+            (gsize)(ind->bytes / (ind->count - 1)) : 0));
+    GByteArray* buf = pooled->bytes;
     gboolean signaled = FALSE;
-
-    /* Protection against hypothetical recursion */
-    if (buf) {
-        priv->buf = NULL;
-    } else {
-        buf = g_byte_array_new();
-    }
+    gboolean ok;
 
     /* Decode the event */
-    g_byte_array_set_size(buf, 0);
-    if (!decode || decode(reader, buf)) {
+    ok = ril_binder_radio_run_decoder(self, decode, reader, buf);
+    RIL_BINDER_TRACE3(decode_indication, ril_code, ok, buf->len);
+    if (ok) {
+        RilBinderRadioPriv* priv = self->priv;
         GRILIO_INDICATION_TYPE type = (ind_type == RADIO_IND_ACK_EXP) ?
             GRILIO_INDICATION_UNSOLICITED_ACK_EXP :
             GRILIO_INDICATION_UNSOLICITED;
+        gboolean suppressed = FALSE;
 
-        grilio_transport_signal_indication(&self->parent, type, ril_code,
-            buf->data, buf->len);
+        if (ril_code == RIL_UNSOL_SIGNAL_STRENGTH && priv->signal.interval) {
+            suppressed = ril_binder_radio_signal_filter(self, ind_type, buf);
+        } else if (priv->dedup_window) {
+            suppressed = ril_binder_radio_dedup_filter(self, ind_type,
+                ril_code, buf);
+        }
+        if (priv->ind_current) {
+            priv->ind_current->bytes += buf->len;
+        }
+        if (!suppressed) {
+            grilio_transport_signal_indication(&self->parent, type, ril_code,
+                buf->data, buf->len);
+        }
         signaled = TRUE;
+    } else if (self->priv->ind_current) {
+        self->priv->ind_current->failed++;
     }
 
-    g_byte_array_set_size(buf, 0);
-    if (priv->buf) {
-        g_byte_array_unref(priv->buf);
-    }
-    priv->buf = buf;
+    ril_binder_radio_buf_release(self, pooled);
     return signaled;
 }
 
+guint
+ril_binder_radio_latency_bucket_limit(
+    guint bucket)
+{
+    return (bucket < RIL_BINDER_RADIO_LATENCY_BUCKETS) ?
+        ril_binder_radio_latency_limits[bucket] : 0;
+}
+
+gboolean
+ril_binder_radio_latency_get(
+    GRilIoTransport* transport,
+    const char* name,
+    RilBinderRadioLatency* out)
+{
+    if (G_LIKELY(transport) && RIL_BINDER_IS_RADIO(transport) && name) {
+        RilBinderRadio* self = RIL_BINDER_RADIO(transport);
+        RilBinderRadioPriv* priv = self->priv;
+        const RilBinderRadioLatency* latency = priv->latency ?
+            g_hash_table_lookup(priv->latency, name) : NULL;
+
+        if (latency) {
+            if (out) {
+                *out = *latency;
+            }
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+RilBinderRadioLatency*
+ril_binder_radio_latency_list(
+    GRilIoTransport* transport,
+    guint* count)
+{
+    RilBinderRadioLatency* list = NULL;
+    guint n = 0;
+
+    if (G_LIKELY(transport) && RIL_BINDER_IS_RADIO(transport)) {
+        RilBinderRadio* self = RIL_BINDER_RADIO(transport);
+        RilBinderRadioPriv* priv = self->priv;
+
+        if (priv->latency && g_hash_table_size(priv->latency)) {
+            GHashTableIter it;
+            gpointer value;
+
+            list = g_new(RilBinderRadioLatency,
+                g_hash_table_size(priv->latency));
+            g_hash_table_iter_init(&it, priv->latency);
+            while (g_hash_table_iter_next(&it, NULL, &value)) {
+                list[n++] = *(RilBinderRadioLatency*)value;
+            }
+        }
+    }
+    if (count) {
+        *count = n;
+    }
+    return list;
+}
+
+void
+ril_binder_radio_latency_reset(
+    GRilIoTransport* transport)
+{
+    if (G_LIKELY(transport) && RIL_BINDER_IS_RADIO(transport)) {
+        RilBinderRadio* self = RIL_BINDER_RADIO(transport);
+        RilBinderRadioPriv* priv = self->priv;
+
+        if (priv->latency) {
+            g_hash_table_remove_all(priv->latency);
+        }
+    }
+}
+
+RilBinderRadioIndStats*
+ril_binder_radio_ind_stats_top(
+    GRilIoTransport* transport,
+    guint max,
+    guint* count)
+{
+    RilBinderRadioIndStats* list = NULL;
+    guint n = 0;
+
+    if (G_LIKELY(transport) && RIL_BINDER_IS_RADIO(transport)) {
+        RilBinderRadio* self = RIL_BINDER_RADIO(transport);
+        RilBinderRadioPriv* priv = self->priv;
+
+        if (priv->ind) {
+            const guint size = priv->tables ? priv->tables->unsol_count : 0;
+            const guint epoch = ril_binder_radio_ind_epoch();
+            guint i;
+
+            list = g_new(RilBinderRadioIndStats, size + 1);
+            for (i = 0; i <= size; i++) {
+                const RilBinderRadioIndCounters* ind = priv->ind + i;
+
+                if (ind->count) {
+                    RilBinderRadioIndStats* stats = list + (n++);
+
+                    stats->code = (i < size) ? i : RIL_BINDER_RADIO_IND_OTHER;
+                    stats->count = ind->count;
+                    stats->unknown = ind->unknown;
+                    stats->failed = ind->failed;
+                    stats->bytes = ind->bytes;
+                    stats->last_minute =
+                        ril_binder_radio_ind_last_minute(ind, epoch);
+                }
+            }
+            if (n) {
+                g_qsort_with_data(list, n, sizeof(list[0]),
+                    ril_binder_radio_ind_stats_compare, NULL);
+                n = MIN(n, max);
+            } else {
+                g_free(list);
+                list = NULL;
+            }
+        }
+    }
+    if (count) {
+        *count = n;
+    }
+    return list;
+}
+
+void
+ril_binder_radio_ind_stats_reset(
+    GRilIoTransport* transport)
+{
+    if (G_LIKELY(transport) && RIL_BINDER_IS_RADIO(transport)) {
+        RilBinderRadio* self = RIL_BINDER_RADIO(transport);
+        RilBinderRadioPriv* priv = self->priv;
+
+        if (priv->ind) {
+            const guint size = priv->tables ? priv->tables->unsol_count : 0;
+
+            memset(priv->ind, 0, sizeof(priv->ind[0]) * (size + 1));
+        }
+    }
+}
+
+RilBinderRadioDedupStats*
+ril_binder_radio_dedup_stats(
+    GRilIoTransport* transport,
+    guint* count)
+{
+    RilBinderRadioDedupStats* list = NULL;
+    guint n = 0;
+
+    if (G_LIKELY(transport) && RIL_BINDER_IS_RADIO(transport)) {
+        RilBinderRadio* self = RIL_BINDER_RADIO(transport);
+        RilBinderRadioPriv* priv = self->priv;
+
+        list = g_new(RilBinderRadioDedupStats, RIL_BINDER_DEDUP_COUNT);
+        for (n = 0; n < RIL_BINDER_DEDUP_COUNT; n++) {
+            list[n].code = ril_binder_radio_dedup_codes[n];
+            list[n].suppressed = priv->dedup[n].suppressed;
+        }
+    }
+    if (count) {
+        *count = n;
+    }
+    return list;
+}
+
+void
+ril_binder_radio_dedup_stats_reset(
+    GRilIoTransport* transport)
+{
+    if (G_LIKELY(transport) && RIL_BINDER_IS_RADIO(transport)) {
+        RilBinderRadio* self = RIL_BINDER_RADIO(transport);
+        RilBinderRadioPriv* priv = self->priv;
+        guint i;
+
+        for (i = 0; i < RIL_BINDER_DEDUP_COUNT; i++) {
+            priv->dedup[i].suppressed = 0;
+        }
+    }
+}
+
+guint
+ril_binder_radio_batch_bucket_limit(
+    guint bucket)
+{
+    return (bucket + 1 < RIL_BINDER_RADIO_BATCH_BUCKETS) ? (1u << bucket) :
+        (bucket < RIL_BINDER_RADIO_BATCH_BUCKETS) ? G_MAXUINT : 0;
+}
+
+gboolean
+ril_binder_radio_batch_stats(
+    GRilIoTransport* transport,
+    RilBinderRadioBatchStats* stats)
+{
+    if (G_LIKELY(transport) && RIL_BINDER_IS_RADIO(transport)) {
+        RilBinderRadio* self = RIL_BINDER_RADIO(transport);
+        RilBinderRadioPriv* priv = self->priv;
+
+        if (stats) {
+            stats->flushes = priv->batch_flushes;
+            memcpy(stats->hist, priv->batch_hist, sizeof(stats->hist));
+        }
+        return TRUE;
+    }
+    return FALSE;
+}
+
+void
+ril_binder_radio_batch_stats_reset(
+    GRilIoTransport* transport)
+{
+    if (G_LIKELY(transport) && RIL_BINDER_IS_RADIO(transport)) {
+        RilBinderRadioPriv* priv = RIL_BINDER_RADIO(transport)->priv;
+
+        priv->batch_flushes = 0;
+        memset(priv->batch_hist, 0, sizeof(priv->batch_hist));
+    }
+}
+
+void
+ril_binder_radio_profile_report(
+    void)
+{
+#ifdef RIL_BINDER_PROFILE
+    GPtrArray* list = g_ptr_array_new();
+    guint i;
+
+    ril_binder_radio_profile_collect(list,
+        ril_binder_radio_profile_encoders);
+    ril_binder_radio_profile_collect(list,
+        ril_binder_radio_profile_decoders);
+    g_ptr_array_sort(list, ril_binder_radio_profile_compare);
+    GINFO("%-6s %-36s %10s %12s %10s %12s %10s", "", "function", "calls",
+        "total ns", "max ns", "bytes", "allocs");
+    for (i = 0; i < list->len; i++) {
+        const RilBinderRadioProfile* prof = list->pdata[i];
+
+        GINFO("%-6s %-36s %10" G_GUINT64_FORMAT " %12" G_GUINT64_FORMAT
+            " %10" G_GUINT64_FORMAT " %12" G_GUINT64_FORMAT " %10"
+            G_GUINT64_FORMAT, prof->kind, prof->name, prof->calls,
+            prof->total_ns, prof->max_ns, prof->bytes, prof->allocs);
+    }
+    if (list->len) {
+        ril_binder_radio_profile_write(list);
+    }
+    g_ptr_array_free(list, TRUE);
+#endif
+}
+
+gboolean
+ril_binder_radio_memory_usage(
+    GRilIoTransport* transport,
+    gsize* current,
+    gsize* peak)
+{
+    if (G_LIKELY(transport) && RIL_BINDER_IS_RADIO(transport)) {
+        const RilBinderRadioMem* mem = RIL_BINDER_RADIO(transport)->priv->mem;
+
+        if (current) {
+            *current = mem->current;
+        }
+        if (peak) {
+            *peak = mem->peak;
+        }
+        return TRUE;
+    }
+    return FALSE;
+}
+
+void
+ril_binder_radio_dump_recorders(
+    void)
+{
+    ril_binder_recorder_dump_all("on demand");
+}
+
 GRilIoTransport*
 ril_binder_radio_new(
     GHashTable* args)
@@ -4740,6 +7162,49 @@ ril_binder_radio_arg_interface(
     return DEFAULT_INTERFACE;
 }
 
+static
+gboolean
+ril_binder_radio_arg_bool(
+    GHashTable* args,
+    const char* key,
+    gboolean def)
+{
+    const char* value = ril_binder_radio_arg_value(args, key, NULL);
+
+    if (value) {
+        if (!g_ascii_strcasecmp(value, "true") ||
+            !g_ascii_strcasecmp(value, "on") ||
+            !g_strcmp0(value, "1")) {
+            return TRUE;
+        } else if (!g_ascii_strcasecmp(value, "false") ||
+            !g_ascii_strcasecmp(value, "off") ||
+            !g_strcmp0(value, "0")) {
+            return FALSE;
+        }
+        GWARN("Invalid %s value '%s'", key, value);
+    }
+    return def;
+}
+
+static
+guint
+ril_binder_radio_arg_uint(
+    GHashTable* args,
+    const char* key,
+    guint def)
+{
+    const char* value = ril_binder_radio_arg_value(args, key, NULL);
+    int n;
+
+    if (value) {
+        if (gutil_parse_int(value, 0, &n) && n >= 0) {
+            return n;
+        }
+        GWARN("Invalid %s value '%s'", key, value);
+    }
+    return def;
+}
+
 gboolean
 ril_binder_radio_init_base(
     RilBinderRadio* self,
@@ -4756,26 +7221,49 @@ ril_binder_radio_init_base(
     if (self->radio) {
         RilBinderRadioPriv* priv = self->priv;
         GBinderServiceManager* sm = gbinder_servicemanager_new(dev);
-
-        /* android.hardware.radio@1.0 */
-        ril_binder_radio_init_version(priv, RADIO_INTERFACE_1_0,
-            ARRAY_AND_COUNT(ril_binder_radio_calls_1_0),
-            ARRAY_AND_COUNT(ril_binder_radio_events_1_0));
-
-         if (self->radio->version >= RADIO_INTERFACE_1_2) {
-            /* android.hardware.radio@1.2 */
-             ril_binder_radio_init_version(priv, RADIO_INTERFACE_1_2,
-                 ARRAY_AND_COUNT(ril_binder_radio_calls_1_2),
-                 ARRAY_AND_COUNT(ril_binder_radio_events_1_2));
+        const char* recorder_dir;
+
+        priv->tables = ril_binder_radio_tables_get(self->radio->version);
+        ril_binder_radio_mem_charge(priv->mem,
+            ril_binder_radio_tables_size(priv->tables));
+        if (ril_binder_radio_arg_bool(args, RIL_BINDER_KEY_ASYNC, FALSE)) {
+            priv->queue_size = MAX(ril_binder_radio_arg_uint(args,
+                RIL_BINDER_KEY_QUEUE, RIL_BINDER_DEFAULT_QUEUE), 1);
+            priv->context = g_main_context_ref_thread_default();
+            priv->pool = g_thread_pool_new(ril_binder_radio_tx_proc, NULL,
+                1, FALSE, NULL);
+            GDEBUG("%sasync mode, queue size %u", self->parent.log_prefix,
+                priv->queue_size);
         }
-
-        if (self->radio->version >= RADIO_INTERFACE_1_4) {
-            /* android.hardware.radio@1.4 */
-            ril_binder_radio_init_version(priv, RADIO_INTERFACE_1_4,
-                ARRAY_AND_COUNT(ril_binder_radio_calls_1_4),
-                ARRAY_AND_COUNT(ril_binder_radio_events_1_4));
+        priv->batch_mode = ril_binder_radio_arg_bool(args,
+            RIL_BINDER_KEY_BATCH, FALSE);
+        priv->buf_trim = ril_binder_radio_arg_uint(args,
+            RIL_BINDER_KEY_BUFFER_TRIM, RIL_BINDER_DEFAULT_BUFFER_TRIM);
+        priv->signal.interval = ril_binder_radio_arg_uint(args,
+            RIL_BINDER_KEY_SIGNAL_INTERVAL, 0);
+        priv->signal.dbm_delta = ril_binder_radio_arg_uint(args,
+            RIL_BINDER_KEY_SIGNAL_DBM_DELTA,
+            RIL_BINDER_DEFAULT_SIGNAL_DBM_DELTA);
+        priv->signal.rsrp_delta = ril_binder_radio_arg_uint(args,
+            RIL_BINDER_KEY_SIGNAL_RSRP_DELTA,
+            RIL_BINDER_DEFAULT_SIGNAL_RSRP_DELTA);
+        priv->signal.rsrq_delta = ril_binder_radio_arg_uint(args,
+            RIL_BINDER_KEY_SIGNAL_RSRQ_DELTA,
+            RIL_BINDER_DEFAULT_SIGNAL_RSRQ_DELTA);
+        priv->dedup_window = ril_binder_radio_arg_uint(args,
+            RIL_BINDER_KEY_DEDUP_WINDOW, 0);
+        priv->apn_cache = ril_binder_radio_arg_bool(args,
+            RIL_BINDER_KEY_APN_CACHE, FALSE);
+        /*
+         * Flight recorder is only there if there's a place to dump it.
+         * Temporary directory is usually cleared on reboot, which is
+         * when post-mortem data is needed the most.
+         */
+        recorder_dir = ril_binder_radio_arg_value(args,
+            RIL_BINDER_KEY_RECORDER_DIR, NULL);
+        if (recorder_dir) {
+            priv->recorder = ril_binder_recorder_new(name, recorder_dir);
         }
-
         priv->oemhook = ril_binder_oemhook_new(sm, self->radio);
         if (priv->oemhook) {
             priv->oemhook_raw_response_id =
@@ -4815,7 +7303,14 @@ ril_binder_radio_init(
 
     self->priv = priv;
     priv->idle = gutil_idle_queue_new();
-    priv->buf = g_byte_array_new();
+    priv->failures.size = RIL_BINDER_FAILURES_INITIAL_SIZE;
+    priv->failures.entry = g_new(RilBinderRadioCompletion,
+        priv->failures.size);
+    priv->buf_trim = RIL_BINDER_DEFAULT_BUFFER_TRIM;
+    priv->mem = ril_binder_radio_mem_new();
+    priv->arena = ril_binder_radio_arena_pool_new(priv->mem);
+    priv->buf[RIL_BINDER_BUF_SMALL][0] = ril_binder_radio_buf_new(self);
+    priv->buf_count[RIL_BINDER_BUF_SMALL] = 1;
 }
 
 static
@@ -4830,18 +7325,38 @@ ril_binder_radio_finalize(
     ril_binder_radio_drop_radio(self);
     gutil_idle_queue_cancel_all(priv->idle);
     gutil_idle_queue_unref(priv->idle);
-    for (i = 0; i < RADIO_INTERFACE_COUNT; i++) {
-        if (priv->req_map[i]) {
-            g_hash_table_destroy(priv->req_map[i]);
-        }
-        if (priv->resp_map[i]) {
-            g_hash_table_destroy(priv->resp_map[i]);
-        }
-        if (priv->unsol_map[i]) {
-            g_hash_table_destroy(priv->unsol_map[i]);
+    ril_binder_radio_batch_clear(self);
+    ril_binder_radio_dedup_clear(self);
+    g_free(priv->failures.entry);
+    if (priv->latency) {
+        g_hash_table_destroy(priv->latency);
+    }
+    g_free(priv->ind);
+    g_free(priv->resp_buf_class);
+    ril_binder_recorder_free(priv->recorder);
+    if (priv->batch_flushes) {
+        /* The final distribution is worth seeing without debug logs */
+        ril_binder_radio_batch_log(self, GLOG_LEVEL_INFO);
+    }
+    g_free(priv->batch);
+    if (priv->tables) {
+        ril_binder_radio_mem_uncharge(priv->mem,
+            ril_binder_radio_tables_size(priv->tables));
+        ril_binder_radio_tables_unref(priv->tables);
+    }
+    if (priv->pool) {
+        /* Each queued transaction holds a reference, nothing is pending */
+        g_thread_pool_free(priv->pool, FALSE, TRUE);
+        g_main_context_unref(priv->context);
+    }
+    for (i = 0; i < RIL_BINDER_BUF_CLASS_COUNT; i++) {
+        while (priv->buf_count[i]) {
+            ril_binder_radio_buf_free(self,
+                priv->buf[i][--priv->buf_count[i]]);
         }
     }
-    g_byte_array_unref(priv->buf);
+    ril_binder_radio_arena_pool_unref(priv->arena);
+    ril_binder_radio_mem_unref(priv->mem);
     G_OBJECT_CLASS(PARENT_CLASS)->finalize(object);
 }
 
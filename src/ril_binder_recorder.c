@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ril_binder_recorder.h"
+#include "ril_binder_log.h"
+
+struct ril_binder_recorder {
+    char* name;
+    char* path;
+    gint index; /* Total number of records ever added, wraps around */
+    RilBinderRecord record[RIL_BINDER_RECORDER_SIZE];
+};
+
+/* All recorders, for on-demand dumps */
+G_LOCK_DEFINE_STATIC(ril_binder_recorders);
+static GSList* ril_binder_recorders = NULL;
+
+G_STATIC_ASSERT(!(RIL_BINDER_RECORDER_SIZE & (RIL_BINDER_RECORDER_SIZE - 1)));
+
+RilBinderRecorder*
+ril_binder_recorder_new(
+    const char* name,
+    const char* dir)
+{
+    RilBinderRecorder* rec = g_new0(RilBinderRecorder, 1);
+    char* file = g_strconcat("ril-binder-", name, ".rec", NULL);
+
+    rec->name = g_strdup(name);
+    rec->path = g_build_filename(dir, file, NULL);
+    g_free(file);
+    G_LOCK(ril_binder_recorders);
+    ril_binder_recorders = g_slist_append(ril_binder_recorders, rec);
+    G_UNLOCK(ril_binder_recorders);
+    return rec;
+}
+
+void
+ril_binder_recorder_free(
+    RilBinderRecorder* rec)
+{
+    if (G_LIKELY(rec)) {
+        G_LOCK(ril_binder_recorders);
+        ril_binder_recorders = g_slist_remove(ril_binder_recorders, rec);
+        G_UNLOCK(ril_binder_recorders);
+        g_free(rec->name);
+        g_free(rec->path);
+        g_free(rec);
+    }
+}
+
+void
+ril_binder_recorder_add(
+    RilBinderRecorder* rec,
+    RIL_BINDER_RECORD_DIR dir,
+    guint code,
+    guint serial,
+    guint error,
+    gsize size)
+{
+    if (G_LIKELY(rec)) {
+        /* Each writer claims its own slot, no locking required */
+        const guint i = ((guint)g_atomic_int_add(&rec->index, 1)) &
+            (RIL_BINDER_RECORDER_SIZE - 1);
+        RilBinderRecord* r = rec->record + i;
+
+        r->timestamp = g_get_monotonic_time();
+        r->serial = serial;
+        r->error = error;
+        r->size = (guint32)MIN(size, G_MAXUINT32);
+        r->code = (guint16)code;
+        r->dir = (guint8)dir;
+        r->reserved = 0;
+    }
+}
+
+gboolean
+ril_binder_recorder_dump(
+    RilBinderRecorder* rec,
+    const char* reason)
+{
+    gboolean ok = FALSE;
+
+    if (G_LIKELY(rec)) {
+        /*
+         * Records still being written by another thread may come out
+         * torn, which is acceptable for post-mortem diagnostics.
+         */
+        const guint total = (guint)g_atomic_int_get(&rec->index);
+        const guint32 count = MIN(total, RIL_BINDER_RECORDER_SIZE);
+        const guint32 version = RIL_BINDER_RECORDER_VERSION;
+        const guint32 size = sizeof(RilBinderRecord);
+        GByteArray* buf = g_byte_array_sized_new(16 + count * size);
+        GError* error = NULL;
+        guint i;
+
+        g_byte_array_append(buf, (const void*)RIL_BINDER_RECORDER_MAGIC, 4);
+        g_byte_array_append(buf, (const void*)&version, sizeof(version));
+        g_byte_array_append(buf, (const void*)&size, sizeof(size));
+        g_byte_array_append(buf, (const void*)&count, sizeof(count));
+        for (i = total - count; i != total; i++) {
+            g_byte_array_append(buf, (const void*)(rec->record +
+                (i & (RIL_BINDER_RECORDER_SIZE - 1))), size);
+        }
+        if (g_file_set_contents(rec->path, (const char*)buf->data,
+            buf->len, &error)) {
+            GINFO("%s: %u record(s) dumped to %s (%s)", rec->name, count,
+                rec->path, reason);
+            ok = TRUE;
+        } else {
+            GERR("%s: %s", rec->name, GERRMSG(error));
+            g_error_free(error);
+        }
+        g_byte_array_unref(buf);
+    }
+    return ok;
+}
+
+void
+ril_binder_recorder_dump_all(
+    const char* reason)
+{
+    GSList* l;
+
+    G_LOCK(ril_binder_recorders);
+    for (l = ril_binder_recorders; l; l = l->next) {
+        ril_binder_recorder_dump(l->data, reason);
+    }
+    G_UNLOCK(ril_binder_recorders);
+}
+
+/*
+ * Local Variables:
+ * mode: C
+ * c-basic-offset: 4
+ * indent-tabs-mode: nil
+ * End:
+ */
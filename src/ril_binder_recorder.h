@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RIL_BINDER_RECORDER_H
+#define RIL_BINDER_RECORDER_H
+
+#include <glib.h>
+
+/*
+ * Fixed size ring of compact binary transaction records. Adding
+ * a record is lock-free and doesn't allocate any memory, the ring
+ * gets dumped to a file when the radio dies or on demand. The file
+ * goes to the directory given to ril_binder_recorder_new(), which
+ * should survive a reboot (i.e. not be a tmpfs).
+ *
+ * Dump file layout (host byte order):
+ *
+ *   "RBFR" version(4) record_size(4) count(4) record[count]
+ *
+ * Records are written oldest first. The code is the HIDL transaction
+ * code (or RIL request code for requests which don't map to IRadio).
+ */
+
+typedef struct ril_binder_recorder RilBinderRecorder;
+
+typedef enum ril_binder_record_dir {
+    RIL_BINDER_RECORD_REQUEST = 1,
+    RIL_BINDER_RECORD_RESPONSE,
+    RIL_BINDER_RECORD_ACK,
+    RIL_BINDER_RECORD_INDICATION,
+    RIL_BINDER_RECORD_FAILURE,  /* Locally completed with an error */
+    RIL_BINDER_RECORD_DEATH
+} RIL_BINDER_RECORD_DIR;
+
+#define RIL_BINDER_RECORDER_MAGIC "RBFR"
+#define RIL_BINDER_RECORDER_VERSION (1)
+#define RIL_BINDER_RECORDER_SIZE (256)
+
+typedef struct ril_binder_record {
+    gint64 timestamp;   /* g_get_monotonic_time() */
+    guint32 serial;
+    guint32 error;
+    guint32 size;       /* Payload size in bytes */
+    guint16 code;
+    guint8 dir;         /* RIL_BINDER_RECORD_DIR */
+    guint8 reserved;
+} RilBinderRecord;
+
+G_STATIC_ASSERT(sizeof(RilBinderRecord) == 24);
+
+RilBinderRecorder*
+ril_binder_recorder_new(
+    const char* name,
+    const char* dir)
+    G_GNUC_INTERNAL;
+
+void
+ril_binder_recorder_free(
+    RilBinderRecorder* rec)
+    G_GNUC_INTERNAL;
+
+void
+ril_binder_recorder_add(
+    RilBinderRecorder* rec,
+    RIL_BINDER_RECORD_DIR dir,
+    guint code,
+    guint serial,
+    guint error,
+    gsize size)
+    G_GNUC_INTERNAL;
+
+gboolean
+ril_binder_recorder_dump(
+    RilBinderRecorder* rec,
+    const char* reason)
+    G_GNUC_INTERNAL;
+
+void
+ril_binder_recorder_dump_all(
+    const char* reason)
+    G_GNUC_INTERNAL;
+
+#endif /* RIL_BINDER_RECORDER_H */
+
+/*
+ * Local Variables:
+ * mode: C
+ * c-basic-offset: 4
+ * indent-tabs-mode: nil
+ * End:
+ */
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef RIL_BINDER_TRACE_H
+#define RIL_BINDER_TRACE_H
+
+/*
+ * USDT tracepoints, compiled in with "make USDT=1". Provider name is
+ * ril_binder, e.g. with bpftrace:
+ *
+ *   bpftrace -e 'usdt:/usr/lib/libgrilio-binder.so.1:ril_binder:send
+ *       { printf("%d %d\n", arg0, arg1); }'
+ *
+ * A detached probe site is a nop, but its arguments are still evaluated.
+ * Probes whose arguments cost anything beyond a register load are
+ * declared with RIL_BINDER_TRACE_SEMAPHORE() and wrapped into
+ * RIL_BINDER_TRACE_ENABLED(), which reads the semaphore the tracer
+ * increments when it attaches. Every probe in a file that includes
+ * this header must have a semaphore. Without USDT=1 the probes (and
+ * their arguments) are compiled out entirely.
+ */
+
+#ifdef RIL_BINDER_USDT
+
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+
+#define RIL_BINDER_TRACE_SEMAPHORE(name) \
+    unsigned short ril_binder_##name##_semaphore \
+    __attribute__((used, section(".probes"), visibility("hidden")))
+#define RIL_BINDER_TRACE_ENABLED(name) \
+    G_UNLIKELY(ril_binder_##name##_semaphore)
+
+#define RIL_BINDER_TRACE1(name,a) \
+    DTRACE_PROBE1(ril_binder,name,a)
+#define RIL_BINDER_TRACE2(name,a,b) \
+    DTRACE_PROBE2(ril_binder,name,a,b)
+#define RIL_BINDER_TRACE3(name,a,b,c) \
+    DTRACE_PROBE3(ril_binder,name,a,b,c)
+#define RIL_BINDER_TRACE4(name,a,b,c,d) \
+    DTRACE_PROBE4(ril_binder,name,a,b,c,d)
+#define RIL_BINDER_TRACE5(name,a,b,c,d,e) \
+    DTRACE_PROBE5(ril_binder,name,a,b,c,d,e)
+
+#else
+
+#define RIL_BINDER_TRACE_SEMAPHORE(name) \
+    extern unsigned short ril_binder_##name##_semaphore
+#define RIL_BINDER_TRACE_ENABLED(name) FALSE
+#define RIL_BINDER_TRACE1(name,a) ((void)0)
+#define RIL_BINDER_TRACE2(name,a,b) ((void)0)
+#define RIL_BINDER_TRACE3(name,a,b,c) ((void)0)
+#define RIL_BINDER_TRACE4(name,a,b,c,d) ((void)0)
+#define RIL_BINDER_TRACE5(name,a,b,c,d,e) ((void)0)
+
+#endif /* RIL_BINDER_USDT */
+
+#endif /* RIL_BINDER_TRACE_H */
+
+/*
+ * Local Variables:
+ * mode: C
+ * c-basic-offset: 4
+ * indent-tabs-mode: nil
+ * End:
+ */
@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_bench.h"
+
+#include <gutil_log.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define TEST_BENCH_DEFAULT_TIME_MS (100)
+#define TEST_BENCH_MAX_N (1000000000)
+
+/* ril_binder_alloc.c */
+extern unsigned long ril_binder_alloc_count(void);
+extern unsigned long ril_binder_alloc_bytes(void);
+extern unsigned long ril_binder_alloc_reallocs(void);
+
+static guint test_bench_time_ms = TEST_BENCH_DEFAULT_TIME_MS;
+static const char* test_bench_filter = NULL;
+static gboolean test_bench_failed = FALSE;
+
+static
+guint64
+test_bench_now_ns(
+    void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (guint64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static
+gboolean
+test_bench_loop(
+    TestBenchFunc fn,
+    gpointer user_data,
+    guint64 n,
+    guint64* ns,
+    unsigned long* allocs,
+    unsigned long* bytes,
+    unsigned long* reallocs)
+{
+    const unsigned long allocs0 = ril_binder_alloc_count();
+    const unsigned long bytes0 = ril_binder_alloc_bytes();
+    const unsigned long reallocs0 = ril_binder_alloc_reallocs();
+    const guint64 start = test_bench_now_ns();
+    guint64 i;
+
+    for (i = 0; i < n; i++) {
+        if (!fn(user_data)) {
+            return FALSE;
+        }
+    }
+    *ns = test_bench_now_ns() - start;
+    *allocs = ril_binder_alloc_count() - allocs0;
+    *bytes = ril_binder_alloc_bytes() - bytes0;
+    *reallocs = ril_binder_alloc_reallocs() - reallocs0;
+    return TRUE;
+}
+
+void
+test_bench_init(
+    int argc,
+    char* argv[])
+{
+    int i;
+
+    /*
+     * Otherwise GSlice (before glib 2.76) serves allocations from its
+     * own magazines, which are invisible to the allocation counter.
+     * Must be done before anything gets allocated from GSlice.
+     */
+    g_setenv("G_SLICE", "always-malloc", TRUE);
+    for (i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+
+        if (!strcmp(arg, "-t") && (i + 1) < argc) {
+            test_bench_time_ms = MAX(atoi(argv[++i]), 1);
+        } else if (!strcmp(arg, "-f") && (i + 1) < argc) {
+            test_bench_filter = argv[++i];
+        } else {
+            GWARN("Unsupported command line option %s", arg);
+        }
+    }
+    gutil_log_default.level = GLOG_LEVEL_NONE;
+}
+
+gboolean
+test_bench_run(
+    const char* name,
+    TestBenchFunc fn,
+    gpointer user_data,
+    TestBenchResult* result)
+{
+    const guint64 budget = (guint64)test_bench_time_ms * 1000000;
+    unsigned long allocs, bytes, reallocs;
+    guint64 n = 1, ns;
+
+    memset(result, 0, sizeof(*result));
+    if (test_bench_filter && !strstr(name, test_bench_filter)) {
+        return TRUE;
+    }
+
+    /* The first (warm-up) iteration also checks that it works at all */
+    if (!test_bench_loop(fn, user_data, n, &ns, &allocs, &bytes,
+        &reallocs)) {
+        test_bench_fail("Benchmark%s failed", name);
+        return FALSE;
+    }
+
+    /* Grow N until the loop runs long enough, as Go does it */
+    while (ns < budget && n < TEST_BENCH_MAX_N) {
+        const guint64 predicted = ns ? (budget * n / ns) : (n * 100);
+
+        n = MIN(MAX(predicted + predicted / 5, n + 1), 100 * n);
+        n = MIN(n, TEST_BENCH_MAX_N);
+        if (!test_bench_loop(fn, user_data, n, &ns, &allocs, &bytes,
+            &reallocs)) {
+            test_bench_fail("Benchmark%s failed", name);
+            return FALSE;
+        }
+    }
+
+    result->n = n;
+    result->ns_per_op = (gdouble)ns / n;
+    result->bytes_per_op = (gdouble)bytes / n;
+    result->allocs_per_op = (gdouble)allocs / n;
+    result->reallocs_per_op = (gdouble)reallocs / n;
+    printf("Benchmark%s\t%" G_GUINT64_FORMAT "\t%.1f ns/op\t%.0f B/op\t"
+        "%.2f allocs/op\t%.2f reallocs/op\n", name, n, result->ns_per_op,
+        result->bytes_per_op, result->allocs_per_op, result->reallocs_per_op);
+    fflush(stdout);
+    return TRUE;
+}
+
+void
+test_bench_fail(
+    const char* format,
+    ...)
+{
+    va_list va;
+
+    va_start(va, format);
+    fputs("FAIL: ", stderr);
+    vfprintf(stderr, format, va);
+    fputc('\n', stderr);
+    va_end(va);
+    test_bench_failed = TRUE;
+}
+
+int
+test_bench_exit(
+    void)
+{
+    return test_bench_failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/*
+ * Local Variables:
+ * mode: C
+ * c-basic-offset: 4
+ * indent-tabs-mode: nil
+ * End:
+ */
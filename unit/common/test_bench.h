@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TEST_BENCH_H
+#define TEST_BENCH_H
+
+/*
+ * Benchmark harness. Each benchmark prints one line in the format
+ * used by Go benchmarks:
+ *
+ *   Benchmark<name> <TAB> N <TAB> x ns/op <TAB> y B/op <TAB> z allocs/op
+ *       <TAB> r reallocs/op
+ *
+ * where reallocs are the allocations which had to grow (or shrink) an
+ * existing block, e.g. GByteArray regrowth. They are included in allocs.
+ *
+ * Memory is counted by ril_binder_alloc.c which has to be linked into
+ * the benchmark executable.
+ */
+
+#include <glib.h>
+
+/* Runs one iteration, returns FALSE on failure */
+typedef
+gboolean
+(*TestBenchFunc)(
+    gpointer user_data);
+
+typedef struct test_bench_result {
+    guint64 n;              /* Zero if the benchmark didn't run */
+    gdouble ns_per_op;
+    gdouble bytes_per_op;
+    gdouble allocs_per_op;
+    gdouble reallocs_per_op;
+} TestBenchResult;
+
+/*
+ * -t MS time per benchmark, -f TEXT only run matching benchmarks.
+ * Must be called first thing in main().
+ */
+void
+test_bench_init(
+    int argc,
+    char* argv[]);
+
+/* Returns FALSE if the function failed (which fails the whole run) */
+gboolean
+test_bench_run(
+    const char* name,
+    TestBenchFunc fn,
+    gpointer user_data,
+    TestBenchResult* result);
+
+void
+test_bench_fail(
+    const char* format,
+    ...) G_GNUC_PRINTF(1,2);
+
+/* Exit code for main() */
+int
+test_bench_exit(
+    void);
+
+#endif /* TEST_BENCH_H */
+
+/*
+ * Local Variables:
+ * mode: C
+ * c-basic-offset: 4
+ * indent-tabs-mode: nil
+ * End:
+ */
@@ -0,0 +1,650 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_gbinder.h"
+
+#include <string.h>
+
+/* Flat representation of a buffer object, same size as in the kernel */
+#define TEST_GBINDER_OBJECT_SIZE (40)
+#define TEST_GBINDER_OBJECT_TAG (0x70742a85) /* BINDER_TYPE_PTR */
+
+typedef struct test_gbinder_object {
+    const void* ptr;
+    gsize size;
+    gint parent;    /* Index of the parent or -1 */
+    gsize offset;   /* Offset of the pointer in the parent */
+} TestGBinderObject;
+
+typedef struct test_gbinder_cleanup {
+    GDestroyNotify destroy;
+    gpointer pointer;
+} TestGBinderCleanup;
+
+struct gbinder_local_request {
+    gint refcount;
+    GByteArray* data;
+    GArray* objects;
+    GArray* cleanups;
+    GPtrArray* allocs;
+};
+
+typedef struct test_gbinder_writer {
+    GBinderLocalRequest* req;
+} TestGBinderWriter;
+
+typedef struct test_gbinder_reader {
+    GBinderLocalRequest* req;
+    gsize pos;
+} TestGBinderReader;
+
+G_STATIC_ASSERT(sizeof(TestGBinderWriter) <= sizeof(GBinderWriter));
+G_STATIC_ASSERT(sizeof(TestGBinderReader) <= sizeof(GBinderReader));
+
+#define test_gbinder_writer_cast(w) ((TestGBinderWriter*)(w))
+#define test_gbinder_reader_cast(r) ((TestGBinderReader*)(r))
+#define test_gbinder_reader_cast_c(r) ((const TestGBinderReader*)(r))
+
+/*==========================================================================*
+ * Request
+ *==========================================================================*/
+
+GBinderLocalRequest*
+test_gbinder_local_request_new(
+    void)
+{
+    GBinderLocalRequest* req = g_slice_new0(GBinderLocalRequest);
+
+    g_atomic_int_set(&req->refcount, 1);
+    req->data = g_byte_array_new();
+    req->objects = g_array_new(FALSE, FALSE, sizeof(TestGBinderObject));
+    req->cleanups = g_array_new(FALSE, FALSE, sizeof(TestGBinderCleanup));
+    req->allocs = g_ptr_array_new_with_free_func(g_free);
+    return req;
+}
+
+static
+void
+test_gbinder_local_request_run_cleanups(
+    GBinderLocalRequest* req)
+{
+    guint i;
+
+    for (i = 0; i < req->cleanups->len; i++) {
+        const TestGBinderCleanup* cleanup = &g_array_index(req->cleanups,
+            TestGBinderCleanup, i);
+
+        cleanup->destroy(cleanup->pointer);
+    }
+    g_array_set_size(req->cleanups, 0);
+}
+
+void
+test_gbinder_local_request_reset(
+    GBinderLocalRequest* req)
+{
+    test_gbinder_local_request_run_cleanups(req);
+    g_array_set_size(req->objects, 0);
+    g_byte_array_set_size(req->data, 0);
+    g_ptr_array_set_size(req->allocs, 0);
+}
+
+void
+test_gbinder_local_request_truncate(
+    GBinderLocalRequest* req,
+    gsize size)
+{
+    if (req->data->len > size) {
+        g_byte_array_set_size(req->data, size);
+    }
+}
+
+static
+void
+test_gbinder_local_request_free(
+    GBinderLocalRequest* req)
+{
+    test_gbinder_local_request_run_cleanups(req);
+    g_array_free(req->cleanups, TRUE);
+    g_array_free(req->objects, TRUE);
+    g_byte_array_free(req->data, TRUE);
+    g_ptr_array_free(req->allocs, TRUE);
+    g_slice_free(GBinderLocalRequest, req);
+}
+
+static
+void*
+test_gbinder_local_request_alloc0(
+    GBinderLocalRequest* req,
+    gsize size)
+{
+    void* ptr = g_malloc0(size);
+
+    g_ptr_array_add(req->allocs, ptr);
+    return ptr;
+}
+
+static
+guint
+test_gbinder_local_request_add_object(
+    GBinderLocalRequest* req,
+    const void* ptr,
+    gsize size,
+    const GBinderParent* parent)
+{
+    const guint index = req->objects->len;
+    guint8 flat[TEST_GBINDER_OBJECT_SIZE];
+    const guint32 tag = TEST_GBINDER_OBJECT_TAG;
+    TestGBinderObject obj;
+
+    obj.ptr = ptr;
+    obj.size = size;
+    obj.parent = parent ? (gint)parent->index : -1;
+    obj.offset = parent ? parent->offset : 0;
+    g_array_append_val(req->objects, obj);
+
+    memset(flat, 0, sizeof(flat));
+    memcpy(flat, &tag, sizeof(tag));
+    memcpy(flat + sizeof(tag), &index, sizeof(index));
+    g_byte_array_append(req->data, flat, sizeof(flat));
+    return index;
+}
+
+guint
+test_gbinder_local_request_object_count(
+    GBinderLocalRequest* req)
+{
+    return req->objects->len;
+}
+
+GBytes*
+test_gbinder_local_request_dump(
+    GBinderLocalRequest* req)
+{
+    GByteArray* dump = g_byte_array_new();
+    guint i, j;
+
+    g_byte_array_append(dump, req->data->data, req->data->len);
+    for (i = 0; i < req->objects->len; i++) {
+        const TestGBinderObject* obj = &g_array_index(req->objects,
+            TestGBinderObject, i);
+        const guint start = dump->len;
+        const guint32 header[3] = {
+            (guint32)obj->parent, (guint32)obj->offset, (guint32)obj->size
+        };
+
+        g_byte_array_append(dump, (const void*)header, sizeof(header));
+        if (obj->size) {
+            g_byte_array_append(dump, obj->ptr, obj->size);
+        }
+
+        /* Zero the pointers to the children of this object */
+        for (j = i + 1; j < req->objects->len; j++) {
+            const TestGBinderObject* child = &g_array_index(req->objects,
+                TestGBinderObject, j);
+
+            if (child->parent == (gint)i &&
+                child->offset + sizeof(guint64) <= obj->size) {
+                memset(dump->data + start + sizeof(header) + child->offset,
+                    0, sizeof(guint64));
+            }
+        }
+    }
+    return g_byte_array_free_to_bytes(dump);
+}
+
+GBinderLocalRequest*
+gbinder_local_request_ref(
+    GBinderLocalRequest* req)
+{
+    if (req) {
+        g_assert_cmpint(req->refcount, > ,0);
+        g_atomic_int_inc(&req->refcount);
+    }
+    return req;
+}
+
+void
+gbinder_local_request_unref(
+    GBinderLocalRequest* req)
+{
+    if (req) {
+        g_assert_cmpint(req->refcount, > ,0);
+        if (g_atomic_int_dec_and_test(&req->refcount)) {
+            test_gbinder_local_request_free(req);
+        }
+    }
+}
+
+void
+gbinder_local_request_init_writer(
+    GBinderLocalRequest* req,
+    GBinderWriter* writer)
+{
+    TestGBinderWriter* self = test_gbinder_writer_cast(writer);
+
+    memset(writer, 0, sizeof(*writer));
+    self->req = req;
+}
+
+void
+gbinder_local_request_cleanup(
+    GBinderLocalRequest* req,
+    GDestroyNotify destroy,
+    gpointer pointer)
+{
+    if (destroy) {
+        TestGBinderCleanup cleanup;
+
+        cleanup.destroy = destroy;
+        cleanup.pointer = pointer;
+        g_array_append_val(req->cleanups, cleanup);
+    }
+}
+
+GBinderLocalRequest*
+gbinder_local_request_append_int32(
+    GBinderLocalRequest* req,
+    guint32 value)
+{
+    if (req) {
+        g_byte_array_append(req->data, (const void*)&value, sizeof(value));
+    }
+    return req;
+}
+
+/*==========================================================================*
+ * Writer
+ *==========================================================================*/
+
+void
+gbinder_writer_append_int32(
+    GBinderWriter* writer,
+    guint32 value)
+{
+    gbinder_local_request_append_int32(test_gbinder_writer_cast(writer)->req,
+        value);
+}
+
+void
+gbinder_writer_overwrite_int32(
+    GBinderWriter* writer,
+    gsize offset,
+    gint32 value)
+{
+    GByteArray* data = test_gbinder_writer_cast(writer)->req->data;
+
+    if (offset + sizeof(value) <= data->len) {
+        memcpy(data->data + offset, &value, sizeof(value));
+    }
+}
+
+void
+gbinder_writer_append_bool(
+    GBinderWriter* writer,
+    gboolean value)
+{
+    /* Padded to 4 bytes, like libgbinder does it */
+    gbinder_writer_append_int32(writer, value ? TRUE : FALSE);
+}
+
+guint
+gbinder_writer_append_buffer_object_with_parent(
+    GBinderWriter* writer,
+    const void* buf,
+    gsize len,
+    const GBinderParent* parent)
+{
+    return test_gbinder_local_request_add_object
+        (test_gbinder_writer_cast(writer)->req, buf, len, parent);
+}
+
+guint
+gbinder_writer_append_buffer_object(
+    GBinderWriter* writer,
+    const void* buf,
+    gsize len)
+{
+    return test_gbinder_local_request_add_object
+        (test_gbinder_writer_cast(writer)->req, buf, len, NULL);
+}
+
+void
+gbinder_writer_append_hidl_vec(
+    GBinderWriter* writer,
+    const void* base,
+    guint count,
+    guint elemsize)
+{
+    GBinderLocalRequest* req = test_gbinder_writer_cast(writer)->req;
+    GBinderHidlVec* vec = test_gbinder_local_request_alloc0(req,
+        sizeof(*vec));
+    GBinderParent parent;
+
+    vec->data.ptr = base;
+    vec->count = count;
+    vec->owns_buffer = TRUE;
+    parent.index = test_gbinder_local_request_add_object(req, vec,
+        sizeof(*vec), NULL);
+    parent.offset = G_STRUCT_OFFSET(GBinderHidlVec, data.ptr);
+    test_gbinder_local_request_add_object(req, base, count * elemsize,
+        &parent);
+}
+
+void
+gbinder_writer_append_hidl_string(
+    GBinderWriter* writer,
+    const char* str)
+{
+    GBinderLocalRequest* req = test_gbinder_writer_cast(writer)->req;
+    GBinderHidlString* hidl = test_gbinder_local_request_alloc0(req,
+        sizeof(*hidl));
+    GBinderParent parent;
+
+    hidl->data.str = str;
+    hidl->len = str ? strlen(str) : 0;
+    hidl->owns_buffer = TRUE;
+    parent.index = test_gbinder_local_request_add_object(req, hidl,
+        sizeof(*hidl), NULL);
+    parent.offset = G_STRUCT_OFFSET(GBinderHidlString, data.str);
+    if (str) {
+        test_gbinder_local_request_add_object(req, str, hidl->len + 1,
+            &parent);
+    }
+}
+
+void
+gbinder_writer_append_hidl_string_vec(
+    GBinderWriter* writer,
+    const char* data[],
+    gssize count)
+{
+    GBinderLocalRequest* req = test_gbinder_writer_cast(writer)->req;
+    GBinderHidlVec* vec = test_gbinder_local_request_alloc0(req,
+        sizeof(*vec));
+    GBinderHidlString* strings;
+    GBinderParent parent;
+    gssize i;
+
+    if (count < 0) {
+        for (count = 0; data && data[count]; count++);
+    }
+    strings = test_gbinder_local_request_alloc0(req,
+        sizeof(GBinderHidlString) * MAX(count, 1));
+    for (i = 0; i < count; i++) {
+        GBinderHidlString* str = strings + i;
+
+        str->data.str = data[i] ? data[i] : "";
+        str->len = strlen(str->data.str);
+        str->owns_buffer = TRUE;
+    }
+    vec->data.ptr = strings;
+    vec->count = count;
+    vec->owns_buffer = TRUE;
+    parent.index = test_gbinder_local_request_add_object(req, vec,
+        sizeof(*vec), NULL);
+    parent.offset = G_STRUCT_OFFSET(GBinderHidlVec, data.ptr);
+    parent.index = test_gbinder_local_request_add_object(req, strings,
+        sizeof(GBinderHidlString) * count, &parent);
+    for (i = 0; i < count; i++) {
+        parent.offset = sizeof(GBinderHidlString) * i +
+            G_STRUCT_OFFSET(GBinderHidlString, data.str);
+        test_gbinder_local_request_add_object(req, strings[i].data.str,
+            strings[i].len + 1, &parent);
+    }
+}
+
+gsize
+gbinder_writer_bytes_written(
+    GBinderWriter* writer)
+{
+    return test_gbinder_writer_cast(writer)->req->data->len;
+}
+
+/*==========================================================================*
+ * Reader
+ *==========================================================================*/
+
+void
+test_gbinder_reader_init(
+    GBinderReader* reader,
+    GBinderLocalRequest* req)
+{
+    TestGBinderReader* self = test_gbinder_reader_cast(reader);
+
+    memset(reader, 0, sizeof(*reader));
+    self->req = req;
+}
+
+static
+const TestGBinderObject*
+test_gbinder_reader_read_object(
+    GBinderReader* reader)
+{
+    TestGBinderReader* self = test_gbinder_reader_cast(reader);
+    GBinderLocalRequest* req = self->req;
+
+    while (self->pos + TEST_GBINDER_OBJECT_SIZE <= req->data->len) {
+        const guint8* flat = req->data->data + self->pos;
+        guint32 tag, index;
+
+        memcpy(&tag, flat, sizeof(tag));
+        memcpy(&index, flat + sizeof(tag), sizeof(index));
+        if (tag != TEST_GBINDER_OBJECT_TAG || index >= req->objects->len) {
+            break;
+        } else {
+            const TestGBinderObject* obj = &g_array_index(req->objects,
+                TestGBinderObject, index);
+
+            self->pos += TEST_GBINDER_OBJECT_SIZE;
+            if (obj->parent < 0) {
+                return obj;
+            }
+            /* Skip the child buffer */
+        }
+    }
+    return NULL;
+}
+
+static
+const TestGBinderObject*
+test_gbinder_reader_child(
+    GBinderReader* reader,
+    const TestGBinderObject* obj,
+    gsize offset)
+{
+    GBinderLocalRequest* req = test_gbinder_reader_cast(reader)->req;
+    const gint index = obj - &g_array_index(req->objects,
+        TestGBinderObject, 0);
+    guint i;
+
+    for (i = index + 1; i < req->objects->len; i++) {
+        const TestGBinderObject* child = &g_array_index(req->objects,
+            TestGBinderObject, i);
+
+        if (child->parent == index && child->offset == offset) {
+            return child;
+        }
+    }
+    return NULL;
+}
+
+gboolean
+gbinder_reader_read_int32(
+    GBinderReader* reader,
+    gint32* value)
+{
+    TestGBinderReader* self = test_gbinder_reader_cast(reader);
+    GByteArray* data = self->req->data;
+
+    if (self->pos + sizeof(*value) <= data->len) {
+        if (value) {
+            memcpy(value, data->data + self->pos, sizeof(*value));
+        }
+        self->pos += sizeof(*value);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+gboolean
+gbinder_reader_read_uint32(
+    GBinderReader* reader,
+    guint32* value)
+{
+    return gbinder_reader_read_int32(reader, (gint32*)value);
+}
+
+gboolean
+gbinder_reader_read_bool(
+    GBinderReader* reader,
+    gboolean* value)
+{
+    gint32 v;
+
+    if (gbinder_reader_read_int32(reader, &v)) {
+        if (value) {
+            *value = (v != 0);
+        }
+        return TRUE;
+    }
+    return FALSE;
+}
+
+const void*
+gbinder_reader_read_hidl_struct1(
+    GBinderReader* reader,
+    gsize size)
+{
+    const TestGBinderObject* obj = test_gbinder_reader_read_object(reader);
+
+    return (obj && obj->size == size) ? obj->ptr : NULL;
+}
+
+const void*
+gbinder_reader_read_hidl_vec1(
+    GBinderReader* reader,
+    gsize* count,
+    guint expected_elem_size)
+{
+    const TestGBinderObject* obj = test_gbinder_reader_read_object(reader);
+    const void* out = NULL;
+    gsize n = 0;
+
+    if (obj && obj->size == sizeof(GBinderHidlVec)) {
+        const GBinderHidlVec* vec = obj->ptr;
+
+        if (vec->count) {
+            const TestGBinderObject* data = test_gbinder_reader_child(reader,
+                obj, G_STRUCT_OFFSET(GBinderHidlVec, data.ptr));
+
+            if (data && data->size == vec->count * expected_elem_size) {
+                n = vec->count;
+                out = data->ptr;
+            }
+        } else {
+            /* Any non-NULL pointer just to indicate success */
+            out = vec;
+        }
+    }
+    if (count) {
+        *count = n;
+    }
+    return out;
+}
+
+const guint8*
+gbinder_reader_read_hidl_byte_vec(
+    GBinderReader* reader,
+    gsize* count)
+{
+    return gbinder_reader_read_hidl_type_vec(reader, guint8, count);
+}
+
+const char*
+gbinder_reader_read_hidl_string_c(
+    GBinderReader* reader)
+{
+    const GBinderHidlString* str = gbinder_reader_read_hidl_struct(reader,
+        GBinderHidlString);
+
+    return str ? str->data.str : NULL;
+}
+
+void
+gbinder_reader_copy(
+    GBinderReader* dest,
+    const GBinderReader* src)
+{
+    memcpy(dest, src, sizeof(*dest));
+}
+
+gsize
+gbinder_reader_bytes_read(
+    const GBinderReader* reader)
+{
+    return test_gbinder_reader_cast_c(reader)->pos;
+}
+
+gsize
+gbinder_reader_bytes_remaining(
+    const GBinderReader* reader)
+{
+    const TestGBinderReader* self = test_gbinder_reader_cast_c(reader);
+
+    return self->req->data->len - self->pos;
+}
+
+/*==========================================================================*
+ * Service manager
+ *==========================================================================*/
+
+GBinderServiceManager*
+gbinder_servicemanager_new(
+    const char* dev)
+{
+    /* There's no service manager, i.e. no IOemHook */
+    return NULL;
+}
+
+void
+gbinder_servicemanager_unref(
+    GBinderServiceManager* sm)
+{
+}
+
+/*
+ * Local Variables:
+ * mode: C
+ * c-basic-offset: 4
+ * indent-tabs-mode: nil
+ * End:
+ */
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TEST_GBINDER_H
+#define TEST_GBINDER_H
+
+/*
+ * In-memory subset of libgbinder parcel API, just enough for the radio
+ * transport. It's linked into the test binaries instead of libgbinder.
+ *
+ * Flat data contains 4-byte integers and a fixed size placeholder for
+ * each buffer object. Buffer objects aren't copied, they must stay alive
+ * as long as the request does (which is what libgbinder requires too).
+ * Reading a top-level buffer object skips its children.
+ */
+
+#include <gbinder.h>
+
+/* As if it came from gbinder_client_new_request() */
+GBinderLocalRequest*
+test_gbinder_local_request_new(
+    void);
+
+/* Reads back the contents of the request */
+void
+test_gbinder_reader_init(
+    GBinderReader* reader,
+    GBinderLocalRequest* req);
+
+/*
+ * Empties the request as if it was freed and allocated again, but
+ * keeps the memory of its own arrays. Used by benchmarks.
+ */
+void
+test_gbinder_local_request_reset(
+    GBinderLocalRequest* req);
+
+/* Drops the flat data past size, as if the parcel was cut short */
+void
+test_gbinder_local_request_truncate(
+    GBinderLocalRequest* req,
+    gsize size);
+
+guint
+test_gbinder_local_request_object_count(
+    GBinderLocalRequest* req);
+
+/*
+ * Flat data followed by buffer objects (parent, offset, size, contents)
+ * with the pointers to child buffers zeroed. Requests encoded from the
+ * same values produce identical dumps regardless of where the values
+ * live in memory.
+ */
+GBytes*
+test_gbinder_local_request_dump(
+    GBinderLocalRequest* req);
+
+#endif /* TEST_GBINDER_H */
+
+/*
+ * Local Variables:
+ * mode: C
+ * c-basic-offset: 4
+ * indent-tabs-mode: nil
+ * End:
+ */
@@ -0,0 +1,1479 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_parcels.h"
+#include "test_gbinder.h"
+
+#include <radio_types.h>
+
+#include <string.h>
+
+/* A buffer which has to be written as a child of another buffer */
+typedef struct test_parcel_ref {
+    const void* field;  /* Where the pointer lives in the parent buffer */
+    const void* data;
+    gsize size;
+    gboolean written;
+} TestParcelRef;
+
+struct test_parcel {
+    GBinderLocalRequest* req;
+    GBinderWriter writer;
+    GArray* refs;
+};
+
+typedef enum test_parcel_cell {
+    TEST_PARCEL_CELL_GSM,
+    TEST_PARCEL_CELL_CDMA,
+    TEST_PARCEL_CELL_LTE,
+    TEST_PARCEL_CELL_WCDMA,
+    TEST_PARCEL_CELL_TDSCDMA,
+    TEST_PARCEL_CELL_COUNT
+} TEST_PARCEL_CELL;
+
+#define test_parcel_new0(p,type) \
+    ((type*)test_parcel_alloc0(p, sizeof(type)))
+#define test_parcel_new_vec(p,vec,type,n) \
+    ((type*)test_parcel_vec(p, vec, n, sizeof(type)))
+#define test_parcel_append_struct(p,ptr) \
+    test_parcel_append(p, ptr, sizeof(*(ptr)))
+
+/*==========================================================================*
+ * Helpers
+ *==========================================================================*/
+
+static
+void*
+test_parcel_alloc0(
+    TestParcel* p,
+    gsize size)
+{
+    void* ptr = g_malloc0(MAX(size, 1));
+
+    gbinder_local_request_cleanup(p->req, g_free, ptr);
+    return ptr;
+}
+
+static
+guint
+test_parcel_count(
+    TEST_PARCEL_SIZE size,
+    guint typical,
+    guint worst)
+{
+    switch (size) {
+    case TEST_PARCEL_TYPICAL:
+        return typical;
+    case TEST_PARCEL_WORST:
+        return worst;
+    default:
+        return 1;
+    }
+}
+
+/* Free text, e.g. operator or contact name */
+static
+const char*
+test_parcel_text(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size,
+    const char* typical)
+{
+    switch (size) {
+    case TEST_PARCEL_TYPICAL:
+        return typical;
+    case TEST_PARCEL_WORST:
+        {
+            char* text = test_parcel_alloc0(p, TEST_PARCEL_MAX_TEXT + 1);
+
+            memset(text, 'W', TEST_PARCEL_MAX_TEXT);
+            return text;
+        }
+    default:
+        return "";
+    }
+}
+
+static
+const char*
+test_parcel_hex(
+    TestParcel* p,
+    gsize nbytes)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    char* str = test_parcel_alloc0(p, 2 * nbytes + 1);
+    gsize i;
+
+    for (i = 0; i < 2 * nbytes; i++) {
+        str[i] = hex[i % 16];
+    }
+    return str;
+}
+
+static
+const char*
+test_parcel_printf(
+    TestParcel* p,
+    const char* format,
+    ...) G_GNUC_PRINTF(2,3);
+
+static
+const char*
+test_parcel_printf(
+    TestParcel* p,
+    const char* format,
+    ...)
+{
+    va_list va;
+    char* str;
+
+    va_start(va, format);
+    str = g_strdup_vprintf(format, va);
+    va_end(va);
+    gbinder_local_request_cleanup(p->req, g_free, str);
+    return str;
+}
+
+static
+void
+test_parcel_ref(
+    TestParcel* p,
+    const void* field,
+    const void* data,
+    gsize size)
+{
+    TestParcelRef ref;
+
+    ref.field = field;
+    ref.data = data;
+    ref.size = size;
+    ref.written = FALSE;
+    g_array_append_val(p->refs, ref);
+}
+
+/* The value must stay alive as long as the request does */
+/* Empty unless it has already been filled in */
+static
+void
+test_parcel_empty_vec(
+    TestParcel* p,
+    GBinderHidlVec* vec)
+{
+    if (!vec->data.ptr) {
+        vec->owns_buffer = TRUE;
+        test_parcel_ref(p, &vec->data.ptr, vec, 0);
+    }
+}
+
+static
+void
+test_parcel_string(
+    TestParcel* p,
+    GBinderHidlString* str,
+    const char* value)
+{
+    str->data.str = value;
+    str->len = strlen(value);
+    str->owns_buffer = TRUE;
+    test_parcel_ref(p, &str->data.str, value, str->len + 1);
+}
+
+static
+void*
+test_parcel_vec(
+    TestParcel* p,
+    GBinderHidlVec* vec,
+    guint count,
+    gsize elemsize)
+{
+    void* data = test_parcel_alloc0(p, count * elemsize);
+
+    vec->data.ptr = data;
+    vec->count = count;
+    vec->owns_buffer = TRUE;
+    test_parcel_ref(p, &vec->data.ptr, data, count * elemsize);
+    return data;
+}
+
+/*
+ * Writes children in the same order as libgbinder does, i.e. depth first
+ * and in the order of the fields within the parent.
+ */
+static
+void
+test_parcel_children(
+    TestParcel* p,
+    const void* buf,
+    gsize size,
+    guint index)
+{
+    const guint8* start = buf;
+    const guint8* end = start + size;
+
+    for (;;) {
+        TestParcelRef* next = NULL;
+        GBinderParent parent;
+        guint i;
+
+        for (i = 0; i < p->refs->len; i++) {
+            TestParcelRef* ref = &g_array_index(p->refs, TestParcelRef, i);
+            const guint8* field = ref->field;
+
+            if (!ref->written && field >= start && field < end &&
+                (!next || field < (const guint8*)next->field)) {
+                next = ref;
+            }
+        }
+        if (!next) {
+            break;
+        }
+        next->written = TRUE;
+        parent.index = index;
+        parent.offset = (const guint8*)next->field - start;
+        test_parcel_children(p, next->data, next->size,
+            gbinder_writer_append_buffer_object_with_parent(&p->writer,
+                next->data, next->size, &parent));
+    }
+}
+
+/* Top level struct, all its strings and vectors must be filled in */
+static
+void
+test_parcel_append(
+    TestParcel* p,
+    const void* buf,
+    gsize size)
+{
+    test_parcel_children(p, buf, size,
+        gbinder_writer_append_buffer_object(&p->writer, buf, size));
+}
+
+static
+void
+test_parcel_append_ints(
+    TestParcel* p,
+    guint count)
+{
+    gint32* ints = test_parcel_alloc0(p, count * sizeof(*ints));
+    guint i;
+
+    for (i = 0; i < count; i++) {
+        ints[i] = i + 1;
+    }
+    gbinder_writer_append_hidl_vec(&p->writer, ints, count, sizeof(*ints));
+}
+
+static
+void
+test_parcel_append_bytes(
+    TestParcel* p,
+    guint count)
+{
+    guint8* bytes = test_parcel_alloc0(p, count);
+    guint i;
+
+    for (i = 0; i < count; i++) {
+        bytes[i] = (guint8)(i * 7);
+    }
+    if (count >= 2) {
+        bytes[count - 2] = 0x90;
+        bytes[count - 1] = 0x00;
+    }
+    gbinder_writer_append_hidl_vec(&p->writer, bytes, count, 1);
+}
+
+/*==========================================================================*
+ * Scalars and strings
+ *==========================================================================*/
+
+static
+void
+test_parcel_build_int32(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    gbinder_writer_append_int32(&p->writer, 1);
+}
+
+static
+void
+test_parcel_build_int_2(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    gbinder_writer_append_int32(&p->writer, 1);
+    gbinder_writer_append_int32(&p->writer, 2);
+}
+
+static
+void
+test_parcel_build_bool(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    gbinder_writer_append_bool(&p->writer, TRUE);
+}
+
+static
+void
+test_parcel_build_string(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    gbinder_writer_append_hidl_string(&p->writer,
+        test_parcel_text(p, size, "244911234567890"));
+}
+
+static
+void
+test_parcel_build_string_3(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    gbinder_writer_append_hidl_string(&p->writer,
+        test_parcel_text(p, size, "Operator Long Name"));
+    gbinder_writer_append_hidl_string(&p->writer,
+        test_parcel_text(p, size, "Operator"));
+    gbinder_writer_append_hidl_string(&p->writer, "24491");
+}
+
+static
+void
+test_parcel_build_int_array(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    test_parcel_append_ints(p, test_parcel_count(size, 4, 64));
+}
+
+static
+void
+test_parcel_build_byte_array(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    test_parcel_append_bytes(p, test_parcel_count(size, 32, 258) + 1);
+}
+
+static
+void
+test_parcel_build_ims_registration_state(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    gbinder_writer_append_bool(&p->writer, TRUE);
+    gbinder_writer_append_int32(&p->writer, 1);
+}
+
+static
+void
+test_parcel_build_icc_open_logical_channel(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    gbinder_writer_append_int32(&p->writer, 1);
+    test_parcel_append_bytes(p, test_parcel_count(size, 32, 258) + 1);
+}
+
+static
+void
+test_parcel_build_call_waiting(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    gbinder_writer_append_bool(&p->writer, TRUE);
+    gbinder_writer_append_int32(&p->writer, 1);
+}
+
+static
+void
+test_parcel_build_pref_network_type_bitmap(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    gbinder_writer_append_int32(&p->writer, RAF_GSM | RAF_GPRS | RAF_EDGE |
+        RAF_UMTS | RAF_HSDPA | RAF_HSUPA | RAF_HSPA | RAF_HSPAP | RAF_LTE);
+}
+
+static
+void
+test_parcel_build_device_identity(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    gbinder_writer_append_hidl_string(&p->writer, "353456789012345");
+    gbinder_writer_append_hidl_string(&p->writer, "01");
+    gbinder_writer_append_hidl_string(&p->writer,
+        test_parcel_text(p, size, "80123456"));
+    gbinder_writer_append_hidl_string(&p->writer,
+        test_parcel_text(p, size, "A0123456789012"));
+}
+
+static
+void
+test_parcel_build_ussd(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    gbinder_writer_append_int32(&p->writer, 0);
+    gbinder_writer_append_hidl_string(&p->writer,
+        test_parcel_text(p, size, "Your balance is 10.00 EUR"));
+}
+
+/*==========================================================================*
+ * SIM
+ *==========================================================================*/
+
+static
+void
+test_parcel_card_status(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size,
+    RadioCardStatus* card)
+{
+    const guint n = test_parcel_count(size, 2, 8);
+    RadioAppStatus* apps = test_parcel_new_vec(p, &card->apps,
+        RadioAppStatus, n);
+    guint i;
+
+    card->cardState = 1;
+    card->universalPinState = 0;
+    card->gsmUmtsSubscriptionAppIndex = 0;
+    card->cdmaSubscriptionAppIndex = -1;
+    card->imsSubscriptionAppIndex = (n > 1) ? 1 : -1;
+    for (i = 0; i < n; i++) {
+        RadioAppStatus* app = apps + i;
+
+        app->appType = (i == 0) ? 2 : 5;
+        app->appState = 5;
+        test_parcel_string(p, &app->aid, test_parcel_printf(p,
+            "A0000000871002FF49FF0589%02X", i));
+        test_parcel_string(p, &app->label, test_parcel_text(p, size,
+            (i == 0) ? "USIM" : "ISIM"));
+        app->pin1 = 2;
+        app->pin2 = 1;
+    }
+}
+
+static
+void
+test_parcel_build_icc_card_status_1_0(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    RadioCardStatus* card = test_parcel_new0(p, RadioCardStatus);
+
+    test_parcel_card_status(p, size, card);
+    test_parcel_append_struct(p, card);
+}
+
+static
+void
+test_parcel_build_icc_card_status_1_2(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    RadioCardStatus_1_2* card = test_parcel_new0(p, RadioCardStatus_1_2);
+
+    test_parcel_card_status(p, size, &card->base);
+    test_parcel_string(p, &card->atr, test_parcel_hex(p, 20));
+    test_parcel_string(p, &card->iccid, "89358011234567890123");
+    test_parcel_append_struct(p, card);
+}
+
+static
+void
+test_parcel_build_icc_card_status_1_4(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    RadioCardStatus_1_4* card = test_parcel_new0(p, RadioCardStatus_1_4);
+
+    test_parcel_card_status(p, size, &card->base);
+    test_parcel_string(p, &card->atr, test_parcel_hex(p, 20));
+    test_parcel_string(p, &card->iccid, "89358011234567890123");
+    test_parcel_string(p, &card->eid, test_parcel_text(p, size,
+        "89049032123451234512345678901234"));
+    test_parcel_append_struct(p, card);
+}
+
+static
+void
+test_parcel_build_icc_io_result(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    RadioIccIoResult* result = test_parcel_new0(p, RadioIccIoResult);
+
+    result->sw1 = 0x90;
+    result->sw2 = 0x00;
+    test_parcel_string(p, &result->response, test_parcel_hex(p,
+        test_parcel_count(size, 32, 256) - 1));
+    test_parcel_append_struct(p, result);
+}
+
+static
+void
+test_parcel_build_sim_refresh(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    RadioSimRefresh* refresh = test_parcel_new0(p, RadioSimRefresh);
+
+    refresh->type = 0;
+    refresh->efId = 0x6f07;
+    test_parcel_string(p, &refresh->aid, test_parcel_text(p, size,
+        "A0000000871002FF49FF0589"));
+    test_parcel_append_struct(p, refresh);
+}
+
+/*==========================================================================*
+ * Network
+ *==========================================================================*/
+
+static
+void
+test_parcel_build_voice_reg_state(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    RadioVoiceRegStateResult* reg = test_parcel_new0(p,
+        RadioVoiceRegStateResult);
+
+    reg->regState = 1;
+    reg->rat = 14;
+    test_parcel_append_struct(p, reg);
+}
+
+static
+void
+test_parcel_build_data_reg_state(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    RadioDataRegStateResult* reg = test_parcel_new0(p,
+        RadioDataRegStateResult);
+
+    reg->regState = 1;
+    reg->rat = 14;
+    reg->maxDataCalls = 4;
+    test_parcel_append_struct(p, reg);
+}
+
+static
+void
+test_parcel_build_data_reg_state_1_4(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    RadioDataRegStateResult_1_4* reg = test_parcel_new0(p,
+        RadioDataRegStateResult_1_4);
+
+    reg->regState = 1;
+    reg->rat = 14;
+    reg->maxDataCalls = 4;
+    test_parcel_append_struct(p, reg);
+}
+
+static
+void
+test_parcel_build_operator_info_list(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    static const gint32 status[] = {
+        RADIO_OP_CURRENT, RADIO_OP_AVAILABLE, RADIO_OP_FORBIDDEN
+    };
+    const guint n = test_parcel_count(size, 6, 30);
+    GBinderHidlVec* vec = test_parcel_new0(p, GBinderHidlVec);
+    RadioOperatorInfo* ops = test_parcel_new_vec(p, vec,
+        RadioOperatorInfo, n);
+    guint i;
+
+    for (i = 0; i < n; i++) {
+        RadioOperatorInfo* op = ops + i;
+
+        test_parcel_string(p, &op->alphaLong, test_parcel_text(p, size,
+            test_parcel_printf(p, "Operator %u", i)));
+        test_parcel_string(p, &op->alphaShort, test_parcel_text(p, size,
+            test_parcel_printf(p, "OP%u", i)));
+        test_parcel_string(p, &op->operatorNumeric,
+            test_parcel_printf(p, "244%02u", i));
+        op->status = status[i % G_N_ELEMENTS(status)];
+    }
+    test_parcel_append_struct(p, vec);
+}
+
+static
+void
+test_parcel_build_signal_strength(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    RadioSignalStrength* ss = test_parcel_new0(p, RadioSignalStrength);
+
+    ss->gw.signalStrength = 20;
+    ss->gw.bitErrorRate = 99;
+    ss->cdma.dbm = ss->evdo.dbm = -1;
+    ss->lte.signalStrength = 25;
+    ss->lte.rsrp = 95;
+    ss->lte.rsrq = 10;
+    ss->lte.rssnr = 100;
+    ss->tdScdma.rscp = G_MAXINT32;
+    test_parcel_append_struct(p, ss);
+}
+
+static
+void
+test_parcel_build_signal_strength_1_2(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    RadioSignalStrength_1_2* ss = test_parcel_new0(p,
+        RadioSignalStrength_1_2);
+
+    ss->gw.signalStrength = 20;
+    ss->gw.bitErrorRate = 99;
+    ss->cdma.dbm = ss->evdo.dbm = -1;
+    ss->lte.signalStrength = 25;
+    ss->lte.rsrp = 95;
+    ss->lte.rsrq = 10;
+    ss->lte.rssnr = 100;
+    ss->tdScdma.rscp = G_MAXINT32;
+    ss->wcdma.base.signalStrength = 15;
+    ss->wcdma.base.bitErrorRate = 99;
+    test_parcel_append_struct(p, ss);
+}
+
+static
+void
+test_parcel_build_signal_strength_1_4(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    RadioSignalStrength_1_4* ss = test_parcel_new0(p,
+        RadioSignalStrength_1_4);
+
+    ss->gsm.signalStrength = 20;
+    ss->gsm.bitErrorRate = 99;
+    ss->cdma.dbm = ss->evdo.dbm = -1;
+    ss->lte.signalStrength = 25;
+    ss->lte.rsrp = 95;
+    ss->lte.rsrq = 10;
+    ss->lte.rssnr = 100;
+    ss->tdscdma.rscp = G_MAXINT32;
+    ss->wcdma.base.signalStrength = 15;
+    ss->wcdma.base.bitErrorRate = 99;
+    test_parcel_append_struct(p, ss);
+}
+
+static
+void
+test_parcel_build_radio_capability(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    RadioCapability* cap = test_parcel_new0(p, RadioCapability);
+
+    cap->raf = RAF_GSM | RAF_UMTS | RAF_LTE;
+    test_parcel_string(p, &cap->logicalModemUuid, test_parcel_text(p, size,
+        "com.example.modem.mdm0"));
+    test_parcel_append_struct(p, cap);
+}
+
+/*==========================================================================*
+ * Cells
+ *==========================================================================*/
+
+static
+TEST_PARCEL_CELL
+test_parcel_cell_type(
+    TEST_PARCEL_SIZE size,
+    guint i)
+{
+    /* The serving LTE cell and its neighbours */
+    static const TEST_PARCEL_CELL typical[] = {
+        TEST_PARCEL_CELL_LTE, TEST_PARCEL_CELL_LTE, TEST_PARCEL_CELL_LTE,
+        TEST_PARCEL_CELL_WCDMA, TEST_PARCEL_CELL_GSM, TEST_PARCEL_CELL_GSM
+    };
+
+    return (size == TEST_PARCEL_WORST) ? (i % TEST_PARCEL_CELL_COUNT) :
+        typical[i % G_N_ELEMENTS(typical)];
+}
+
+static
+void
+test_parcel_cell_gsm(
+    TestParcel* p,
+    RadioCellIdentityGsm* id,
+    RadioSignalStrengthGsm* ss,
+    guint i)
+{
+    test_parcel_string(p, &id->mcc, "244");
+    test_parcel_string(p, &id->mnc, "91");
+    id->lac = 1000 + i;
+    id->cid = 20000 + i;
+    id->arfcn = 60 + i;
+    id->bsic = 7;
+    ss->signalStrength = 20;
+    ss->bitErrorRate = 99;
+    ss->timingAdvance = G_MAXINT32;
+}
+
+static
+void
+test_parcel_cell_cdma(
+    RadioCellIdentityCdma* id,
+    RadioSignalStrengthCdma* ss,
+    RadioSignalStrengthEvdo* evdo,
+    guint i)
+{
+    id->networkId = 1;
+    id->systemId = 2;
+    id->baseStationId = 3000 + i;
+    id->longitude = 24 * 14400;
+    id->latitude = 60 * 14400;
+    ss->dbm = 75;
+    ss->ecio = 90;
+    evdo->dbm = 75;
+    evdo->ecio = 90;
+    evdo->signalNoiseRatio = 8;
+}
+
+static
+void
+test_parcel_cell_lte(
+    TestParcel* p,
+    RadioCellIdentityLte* id,
+    RadioSignalStrengthLte* ss,
+    guint i)
+{
+    test_parcel_string(p, &id->mcc, "244");
+    test_parcel_string(p, &id->mnc, "91");
+    id->ci = 30000000 + i;
+    id->pci = 100 + i;
+    id->tac = 4000;
+    id->earfcn = 6300;
+    ss->signalStrength = 25;
+    ss->rsrp = 95;
+    ss->rsrq = 10;
+    ss->rssnr = 100;
+    ss->cqi = G_MAXINT32;
+    ss->timingAdvance = G_MAXINT32;
+}
+
+static
+void
+test_parcel_cell_wcdma(
+    TestParcel* p,
+    RadioCellIdentityWcdma* id,
+    RadioSignalStrengthWcdma* ss,
+    guint i)
+{
+    test_parcel_string(p, &id->mcc, "244");
+    test_parcel_string(p, &id->mnc, "91");
+    id->lac = 1000 + i;
+    id->cid = 40000 + i;
+    id->psc = 200 + i;
+    id->uarfcn = 10700;
+    ss->signalStrength = 15;
+    ss->bitErrorRate = 99;
+}
+
+static
+void
+test_parcel_cell_tdscdma(
+    TestParcel* p,
+    RadioCellIdentityTdscdma* id,
+    guint i)
+{
+    test_parcel_string(p, &id->mcc, "460");
+    test_parcel_string(p, &id->mnc, "00");
+    id->lac = 1000 + i;
+    id->cid = 50000 + i;
+    id->cpid = 10 + i;
+}
+
+static
+void
+test_parcel_cell_names(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size,
+    RadioCellIdentityOperatorNames* names)
+{
+    test_parcel_string(p, &names->alphaLong, test_parcel_text(p, size,
+        "Operator Long Name"));
+    test_parcel_string(p, &names->alphaShort, test_parcel_text(p, size,
+        "Operator"));
+}
+
+static
+void
+test_parcel_build_cell_info_list(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    static const gint32 type[TEST_PARCEL_CELL_COUNT] = {
+        RADIO_CELL_INFO_GSM, RADIO_CELL_INFO_CDMA, RADIO_CELL_INFO_LTE,
+        RADIO_CELL_INFO_WCDMA, RADIO_CELL_INFO_TD_SCDMA
+    };
+    const guint n = test_parcel_count(size, 6, 40);
+    GBinderHidlVec* vec = test_parcel_new0(p, GBinderHidlVec);
+    RadioCellInfo* cells = test_parcel_new_vec(p, vec, RadioCellInfo, n);
+    guint i;
+
+    for (i = 0; i < n; i++) {
+        RadioCellInfo* cell = cells + i;
+        const TEST_PARCEL_CELL t = test_parcel_cell_type(size, i);
+
+        cell->cellInfoType = type[t];
+        cell->registered = (i == 0);
+        cell->timeStampType = 1;
+        cell->timeStamp = G_GUINT64_CONSTANT(1000000000) * (i + 1);
+        switch (t) {
+        case TEST_PARCEL_CELL_GSM:
+            {
+                RadioCellInfoGsm* info = test_parcel_new_vec(p, &cell->gsm,
+                    RadioCellInfoGsm, 1);
+
+                test_parcel_cell_gsm(p, &info->cellIdentityGsm,
+                    &info->signalStrengthGsm, i);
+            }
+            break;
+        case TEST_PARCEL_CELL_CDMA:
+            {
+                RadioCellInfoCdma* info = test_parcel_new_vec(p,
+                    &cell->cdma, RadioCellInfoCdma, 1);
+
+                test_parcel_cell_cdma(&info->cellIdentityCdma,
+                    &info->signalStrengthCdma, &info->signalStrengthEvdo, i);
+            }
+            break;
+        case TEST_PARCEL_CELL_LTE:
+            {
+                RadioCellInfoLte* info = test_parcel_new_vec(p, &cell->lte,
+                    RadioCellInfoLte, 1);
+
+                test_parcel_cell_lte(p, &info->cellIdentityLte,
+                    &info->signalStrengthLte, i);
+            }
+            break;
+        case TEST_PARCEL_CELL_WCDMA:
+            {
+                RadioCellInfoWcdma* info = test_parcel_new_vec(p,
+                    &cell->wcdma, RadioCellInfoWcdma, 1);
+
+                test_parcel_cell_wcdma(p, &info->cellIdentityWcdma,
+                    &info->signalStrengthWcdma, i);
+            }
+            break;
+        case TEST_PARCEL_CELL_TDSCDMA:
+            {
+                RadioCellInfoTdscdma* info = test_parcel_new_vec(p,
+                    &cell->tdscdma, RadioCellInfoTdscdma, 1);
+
+                test_parcel_cell_tdscdma(p, &info->cellIdentityTdscdma, i);
+                info->signalStrengthTdscdma.rscp = 60;
+            }
+            break;
+        case TEST_PARCEL_CELL_COUNT:
+            break;
+        }
+        test_parcel_empty_vec(p, &cell->gsm);
+        test_parcel_empty_vec(p, &cell->cdma);
+        test_parcel_empty_vec(p, &cell->lte);
+        test_parcel_empty_vec(p, &cell->wcdma);
+        test_parcel_empty_vec(p, &cell->tdscdma);
+    }
+    test_parcel_append_struct(p, vec);
+}
+
+static
+void
+test_parcel_build_cell_info_list_1_2(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    static const gint32 type[TEST_PARCEL_CELL_COUNT] = {
+        RADIO_CELL_INFO_GSM, RADIO_CELL_INFO_CDMA, RADIO_CELL_INFO_LTE,
+        RADIO_CELL_INFO_WCDMA, RADIO_CELL_INFO_TD_SCDMA
+    };
+    const guint n = test_parcel_count(size, 6, 40);
+    GBinderHidlVec* vec = test_parcel_new0(p, GBinderHidlVec);
+    RadioCellInfo_1_2* cells = test_parcel_new_vec(p, vec,
+        RadioCellInfo_1_2, n);
+    guint i;
+
+    for (i = 0; i < n; i++) {
+        RadioCellInfo_1_2* cell = cells + i;
+        const TEST_PARCEL_CELL t = test_parcel_cell_type(size, i);
+
+        cell->cellInfoType = type[t];
+        cell->registered = (i == 0);
+        cell->timeStampType = 1;
+        cell->timeStamp = G_GUINT64_CONSTANT(1000000000) * (i + 1);
+        cell->connectionStatus = (i == 0) ? 1 : 0;
+        switch (t) {
+        case TEST_PARCEL_CELL_GSM:
+            {
+                RadioCellInfoGsm_1_2* info = test_parcel_new_vec(p,
+                    &cell->gsm, RadioCellInfoGsm_1_2, 1);
+
+                test_parcel_cell_gsm(p, &info->cellIdentityGsm.base,
+                    &info->signalStrengthGsm, i);
+                test_parcel_cell_names(p, size,
+                    &info->cellIdentityGsm.operatorNames);
+            }
+            break;
+        case TEST_PARCEL_CELL_CDMA:
+            {
+                RadioCellInfoCdma_1_2* info = test_parcel_new_vec(p,
+                    &cell->cdma, RadioCellInfoCdma_1_2, 1);
+
+                test_parcel_cell_cdma(&info->cellIdentityCdma.base,
+                    &info->signalStrengthCdma, &info->signalStrengthEvdo, i);
+                test_parcel_cell_names(p, size,
+                    &info->cellIdentityCdma.operatorNames);
+            }
+            break;
+        case TEST_PARCEL_CELL_LTE:
+            {
+                RadioCellInfoLte_1_2* info = test_parcel_new_vec(p,
+                    &cell->lte, RadioCellInfoLte_1_2, 1);
+
+                test_parcel_cell_lte(p, &info->cellIdentityLte.base,
+                    &info->signalStrengthLte, i);
+                test_parcel_cell_names(p, size,
+                    &info->cellIdentityLte.operatorNames);
+                info->cellIdentityLte.bandwidth = 20000;
+            }
+            break;
+        case TEST_PARCEL_CELL_WCDMA:
+            {
+                RadioCellInfoWcdma_1_2* info = test_parcel_new_vec(p,
+                    &cell->wcdma, RadioCellInfoWcdma_1_2, 1);
+
+                test_parcel_cell_wcdma(p, &info->cellIdentityWcdma.base,
+                    &info->signalStrengthWcdma.base, i);
+                test_parcel_cell_names(p, size,
+                    &info->cellIdentityWcdma.operatorNames);
+            }
+            break;
+        case TEST_PARCEL_CELL_TDSCDMA:
+            {
+                RadioCellInfoTdscdma_1_2* info = test_parcel_new_vec(p,
+                    &cell->tdscdma, RadioCellInfoTdscdma_1_2, 1);
+
+                test_parcel_cell_tdscdma(p,
+                    &info->cellIdentityTdscdma.base, i);
+                test_parcel_cell_names(p, size,
+                    &info->cellIdentityTdscdma.operatorNames);
+                info->signalStrengthTdscdma.rscp = 60;
+            }
+            break;
+        case TEST_PARCEL_CELL_COUNT:
+            break;
+        }
+        test_parcel_empty_vec(p, &cell->gsm);
+        test_parcel_empty_vec(p, &cell->cdma);
+        test_parcel_empty_vec(p, &cell->lte);
+        test_parcel_empty_vec(p, &cell->wcdma);
+        test_parcel_empty_vec(p, &cell->tdscdma);
+    }
+    test_parcel_append_struct(p, vec);
+}
+
+static
+void
+test_parcel_build_cell_info_list_1_4(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    static const gint32 type[TEST_PARCEL_CELL_COUNT] = {
+        RADIO_CELL_INFO_1_4_GSM, RADIO_CELL_INFO_1_4_CDMA,
+        RADIO_CELL_INFO_1_4_LTE, RADIO_CELL_INFO_1_4_WCDMA,
+        RADIO_CELL_INFO_1_4_TD_SCDMA
+    };
+    const guint n = test_parcel_count(size, 6, 40);
+    GBinderHidlVec* vec = test_parcel_new0(p, GBinderHidlVec);
+    RadioCellInfo_1_4* cells = test_parcel_new_vec(p, vec,
+        RadioCellInfo_1_4, n);
+    guint i;
+
+    for (i = 0; i < n; i++) {
+        RadioCellInfo_1_4* cell = cells + i;
+        const TEST_PARCEL_CELL t = test_parcel_cell_type(size, i);
+
+        cell->cellInfoType = type[t];
+        cell->registered = (i == 0);
+        cell->connectionStatus = (i == 0) ? 1 : 0;
+        switch (t) {
+        case TEST_PARCEL_CELL_GSM:
+            test_parcel_cell_gsm(p, &cell->info.gsm.cellIdentityGsm.base,
+                &cell->info.gsm.signalStrengthGsm, i);
+            test_parcel_cell_names(p, size,
+                &cell->info.gsm.cellIdentityGsm.operatorNames);
+            break;
+        case TEST_PARCEL_CELL_CDMA:
+            test_parcel_cell_cdma(&cell->info.cdma.cellIdentityCdma.base,
+                &cell->info.cdma.signalStrengthCdma,
+                &cell->info.cdma.signalStrengthEvdo, i);
+            test_parcel_cell_names(p, size,
+                &cell->info.cdma.cellIdentityCdma.operatorNames);
+            break;
+        case TEST_PARCEL_CELL_LTE:
+            test_parcel_cell_lte(p,
+                &cell->info.lte.base.cellIdentityLte.base,
+                &cell->info.lte.base.signalStrengthLte, i);
+            test_parcel_cell_names(p, size,
+                &cell->info.lte.base.cellIdentityLte.operatorNames);
+            cell->info.lte.base.cellIdentityLte.bandwidth = 20000;
+            break;
+        case TEST_PARCEL_CELL_WCDMA:
+            test_parcel_cell_wcdma(p,
+                &cell->info.wcdma.cellIdentityWcdma.base,
+                &cell->info.wcdma.signalStrengthWcdma.base, i);
+            test_parcel_cell_names(p, size,
+                &cell->info.wcdma.cellIdentityWcdma.operatorNames);
+            break;
+        case TEST_PARCEL_CELL_TDSCDMA:
+            test_parcel_cell_tdscdma(p,
+                &cell->info.tdscdma.cellIdentityTdscdma.base, i);
+            test_parcel_cell_names(p, size,
+                &cell->info.tdscdma.cellIdentityTdscdma.operatorNames);
+            cell->info.tdscdma.signalStrengthTdscdma.rscp = 60;
+            break;
+        case TEST_PARCEL_CELL_COUNT:
+            break;
+        }
+    }
+    test_parcel_append_struct(p, vec);
+}
+
+/*==========================================================================*
+ * Calls and supplementary services
+ *==========================================================================*/
+
+static
+void
+test_parcel_call(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size,
+    RadioCall* call,
+    guint i)
+{
+    call->state = (i == 0) ? 0 : 1;
+    call->index = i + 1;
+    call->toa = 145;
+    call->isMT = (i & 1);
+    call->isVoice = TRUE;
+    test_parcel_string(p, &call->number, test_parcel_printf(p,
+        "+35840123456%u", i % 10));
+    test_parcel_string(p, &call->name, test_parcel_text(p, size,
+        "John Doe"));
+    test_parcel_empty_vec(p, &call->uusInfo);
+}
+
+static
+void
+test_parcel_build_call_list(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    const guint n = test_parcel_count(size, 2, 7);
+    GBinderHidlVec* vec = test_parcel_new0(p, GBinderHidlVec);
+    RadioCall* calls = test_parcel_new_vec(p, vec, RadioCall, n);
+    guint i;
+
+    for (i = 0; i < n; i++) {
+        test_parcel_call(p, size, calls + i, i);
+    }
+    test_parcel_append_struct(p, vec);
+}
+
+static
+void
+test_parcel_build_call_list_1_2(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    const guint n = test_parcel_count(size, 2, 7);
+    GBinderHidlVec* vec = test_parcel_new0(p, GBinderHidlVec);
+    RadioCall_1_2* calls = test_parcel_new_vec(p, vec, RadioCall_1_2, n);
+    guint i;
+
+    for (i = 0; i < n; i++) {
+        test_parcel_call(p, size, &calls[i].base, i);
+        calls[i].audioQuality = 2;
+    }
+    test_parcel_append_struct(p, vec);
+}
+
+static
+void
+test_parcel_build_last_call_fail_cause(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    RadioLastCallFailCauseInfo* info = test_parcel_new0(p,
+        RadioLastCallFailCauseInfo);
+
+    info->causeCode = 16;
+    test_parcel_string(p, &info->vendorCause, test_parcel_text(p, size,
+        "Normal call clearing"));
+    test_parcel_append_struct(p, info);
+}
+
+static
+void
+test_parcel_build_call_forward_info_array(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    const guint n = test_parcel_count(size, 2, 8);
+    GBinderHidlVec* vec = test_parcel_new0(p, GBinderHidlVec);
+    RadioCallForwardInfo* infos = test_parcel_new_vec(p, vec,
+        RadioCallForwardInfo, n);
+    guint i;
+
+    for (i = 0; i < n; i++) {
+        RadioCallForwardInfo* info = infos + i;
+
+        info->status = 1;
+        info->reason = i % 6;
+        info->serviceClass = 1;
+        info->toa = 145;
+        test_parcel_string(p, &info->number, "+358401234567");
+        info->timeSeconds = 20;
+    }
+    test_parcel_append_struct(p, vec);
+}
+
+static
+void
+test_parcel_build_supp_svc_notification(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    RadioSuppSvcNotification* notify = test_parcel_new0(p,
+        RadioSuppSvcNotification);
+
+    notify->isMT = 1;
+    notify->code = 2;
+    notify->type = 145;
+    test_parcel_string(p, &notify->number, test_parcel_text(p, size,
+        "+358401234567"));
+    test_parcel_append_struct(p, notify);
+}
+
+/*==========================================================================*
+ * SMS
+ *==========================================================================*/
+
+static
+void
+test_parcel_build_sms_send_result(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    RadioSendSmsResult* result = test_parcel_new0(p, RadioSendSmsResult);
+
+    result->messageRef = 42;
+    test_parcel_string(p, &result->ackPDU, test_parcel_text(p, size, ""));
+    result->errorCode = -1;
+    test_parcel_append_struct(p, result);
+}
+
+static
+void
+test_parcel_build_gsm_broadcast_sms_config(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    const guint n = test_parcel_count(size, 4, 32);
+    GBinderHidlVec* vec = test_parcel_new0(p, GBinderHidlVec);
+    RadioGsmBroadcastSmsConfig* configs = test_parcel_new_vec(p, vec,
+        RadioGsmBroadcastSmsConfig, n);
+    guint i;
+
+    for (i = 0; i < n; i++) {
+        RadioGsmBroadcastSmsConfig* config = configs + i;
+
+        config->fromServiceId = 4352 + 2 * i;
+        config->toServiceId = 4353 + 2 * i;
+        config->fromCodeScheme = 0;
+        config->toCodeScheme = 255;
+        config->selected = TRUE;
+    }
+    test_parcel_append_struct(p, vec);
+}
+
+/*==========================================================================*
+ * Data calls
+ *==========================================================================*/
+
+static
+void
+test_parcel_data_call(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size,
+    RadioDataCall* call,
+    guint i)
+{
+    call->cid = i + 1;
+    call->active = 2;
+    test_parcel_string(p, &call->type, "IPV4V6");
+    test_parcel_string(p, &call->ifname, test_parcel_printf(p,
+        "rmnet_data%u", i));
+    test_parcel_string(p, &call->addresses, (size == TEST_PARCEL_SMALL) ?
+        "10.0.0.2/32" : "10.0.0.2/32 2001:db8::2/64");
+    test_parcel_string(p, &call->dnses, (size == TEST_PARCEL_SMALL) ?
+        "10.0.0.1" : "10.0.0.1 10.0.0.3 2001:db8::1 2001:db8::3");
+    test_parcel_string(p, &call->gateways, "10.0.0.1");
+    test_parcel_string(p, &call->pcscf, (size == TEST_PARCEL_WORST) ?
+        "2001:db8::10 2001:db8::11" : "");
+    call->mtu = 1500;
+}
+
+static
+void
+test_parcel_string_vec(
+    TestParcel* p,
+    GBinderHidlVec* vec,
+    guint count,
+    const char* format)
+{
+    GBinderHidlString* strings = test_parcel_new_vec(p, vec,
+        GBinderHidlString, count);
+    guint i;
+
+    for (i = 0; i < count; i++) {
+        test_parcel_string(p, strings + i, test_parcel_printf(p, format,
+            i + 1));
+    }
+}
+
+static
+void
+test_parcel_data_call_1_4(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size,
+    RadioDataCall_1_4* call,
+    guint i)
+{
+    const guint n = test_parcel_count(size, 2, 8);
+
+    call->cid = i + 1;
+    call->active = 2;
+    call->type = 3;
+    test_parcel_string(p, &call->ifname, test_parcel_printf(p,
+        "rmnet_data%u", i));
+    test_parcel_string_vec(p, &call->addresses, n, "2001:db8::%u/64");
+    test_parcel_string_vec(p, &call->dnses, n, "2001:db8::%u");
+    test_parcel_string_vec(p, &call->gateways, 1, "fe80::%u");
+    test_parcel_string_vec(p, &call->pcscf, n - 1, "2001:db8:1::%u");
+    call->mtu = 1500;
+}
+
+static
+void
+test_parcel_build_setup_data_call_result(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    RadioDataCall* call = test_parcel_new0(p, RadioDataCall);
+
+    test_parcel_data_call(p, size, call, 0);
+    test_parcel_append_struct(p, call);
+}
+
+static
+void
+test_parcel_build_setup_data_call_result_1_4(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    RadioDataCall_1_4* call = test_parcel_new0(p, RadioDataCall_1_4);
+
+    test_parcel_data_call_1_4(p, size, call, 0);
+    test_parcel_append_struct(p, call);
+}
+
+static
+void
+test_parcel_build_data_call_list(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    const guint n = test_parcel_count(size, 2, 8);
+    GBinderHidlVec* vec = test_parcel_new0(p, GBinderHidlVec);
+    RadioDataCall* calls = test_parcel_new_vec(p, vec, RadioDataCall, n);
+    guint i;
+
+    for (i = 0; i < n; i++) {
+        test_parcel_data_call(p, size, calls + i, i);
+    }
+    test_parcel_append_struct(p, vec);
+}
+
+static
+void
+test_parcel_build_data_call_list_1_4(
+    TestParcel* p,
+    TEST_PARCEL_SIZE size)
+{
+    const guint n = test_parcel_count(size, 2, 8);
+    GBinderHidlVec* vec = test_parcel_new0(p, GBinderHidlVec);
+    RadioDataCall_1_4* calls = test_parcel_new_vec(p, vec,
+        RadioDataCall_1_4, n);
+    guint i;
+
+    for (i = 0; i < n; i++) {
+        test_parcel_data_call_1_4(p, size, calls + i, i);
+    }
+    test_parcel_append_struct(p, vec);
+}
+
+/*==========================================================================*
+ * API
+ *==========================================================================*/
+
+#define TEST_PARCEL_TYPE(name) { #name, test_parcel_build_##name }
+#define TEST_PARCEL_TYPE_AS(name,as) { #name, test_parcel_build_##as }
+
+static const TestParcelType test_parcel_type_list[] = {
+    TEST_PARCEL_TYPE(int32),
+    TEST_PARCEL_TYPE_AS(int_1, int32),
+    TEST_PARCEL_TYPE(int_2),
+    TEST_PARCEL_TYPE_AS(bool_to_int_array, bool),
+    TEST_PARCEL_TYPE(string),
+    TEST_PARCEL_TYPE(string_3),
+    TEST_PARCEL_TYPE(int_array),
+    TEST_PARCEL_TYPE(byte_array),
+    TEST_PARCEL_TYPE_AS(byte_array_to_hex, byte_array),
+    TEST_PARCEL_TYPE(ims_registration_state),
+    TEST_PARCEL_TYPE(icc_open_logical_channel),
+    TEST_PARCEL_TYPE(icc_card_status_1_0),
+    TEST_PARCEL_TYPE(icc_card_status_1_2),
+    TEST_PARCEL_TYPE(icc_card_status_1_4),
+    TEST_PARCEL_TYPE(icc_io_result),
+    TEST_PARCEL_TYPE(sim_refresh),
+    TEST_PARCEL_TYPE(voice_reg_state),
+    TEST_PARCEL_TYPE(data_reg_state),
+    TEST_PARCEL_TYPE(data_reg_state_1_4),
+    TEST_PARCEL_TYPE(operator_info_list),
+    TEST_PARCEL_TYPE_AS(pref_network_type, int32),
+    TEST_PARCEL_TYPE(pref_network_type_bitmap),
+    TEST_PARCEL_TYPE(signal_strength),
+    TEST_PARCEL_TYPE(signal_strength_1_2),
+    TEST_PARCEL_TYPE(signal_strength_1_4),
+    TEST_PARCEL_TYPE(radio_capability),
+    TEST_PARCEL_TYPE(cell_info_list),
+    TEST_PARCEL_TYPE(cell_info_list_1_2),
+    TEST_PARCEL_TYPE(cell_info_list_1_4),
+    TEST_PARCEL_TYPE(call_list),
+    TEST_PARCEL_TYPE(call_list_1_2),
+    TEST_PARCEL_TYPE(last_call_fail_cause),
+    TEST_PARCEL_TYPE(call_forward_info_array),
+    TEST_PARCEL_TYPE(call_waiting),
+    TEST_PARCEL_TYPE(supp_svc_notification),
+    TEST_PARCEL_TYPE(ussd),
+    TEST_PARCEL_TYPE(device_identity),
+    TEST_PARCEL_TYPE(sms_send_result),
+    TEST_PARCEL_TYPE(gsm_broadcast_sms_config),
+    TEST_PARCEL_TYPE(setup_data_call_result),
+    TEST_PARCEL_TYPE(setup_data_call_result_1_4),
+    TEST_PARCEL_TYPE(data_call_list),
+    TEST_PARCEL_TYPE(data_call_list_1_4)
+};
+
+const TestParcelType*
+test_parcel_types(
+    guint* count)
+{
+    *count = G_N_ELEMENTS(test_parcel_type_list);
+    return test_parcel_type_list;
+}
+
+const TestParcelType*
+test_parcel_type_find(
+    const char* name)
+{
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS(test_parcel_type_list); i++) {
+        if (!g_strcmp0(test_parcel_type_list[i].name, name)) {
+            return test_parcel_type_list + i;
+        }
+    }
+    return NULL;
+}
+
+const char*
+test_parcel_size_name(
+    TEST_PARCEL_SIZE size)
+{
+    switch (size) {
+    case TEST_PARCEL_SMALL:
+        return "small";
+    case TEST_PARCEL_TYPICAL:
+        return "typical";
+    case TEST_PARCEL_WORST:
+        return "worst";
+    case TEST_PARCEL_SIZE_COUNT:
+        break;
+    }
+    return NULL;
+}
+
+GBinderLocalRequest*
+test_parcel_new(
+    const TestParcelType* type,
+    TEST_PARCEL_SIZE size)
+{
+    TestParcel parcel;
+
+    memset(&parcel, 0, sizeof(parcel));
+    parcel.req = test_gbinder_local_request_new();
+    parcel.refs = g_array_new(FALSE, FALSE, sizeof(TestParcelRef));
+    gbinder_local_request_init_writer(parcel.req, &parcel.writer);
+    type->build(&parcel, size);
+    g_array_free(parcel.refs, TRUE);
+    return parcel.req;
+}
+
+/*
+ * Local Variables:
+ * mode: C
+ * c-basic-offset: 4
+ * indent-tabs-mode: nil
+ * End:
+ */
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TEST_PARCELS_H
+#define TEST_PARCELS_H
+
+/*
+ * Synthetic HIDL payloads for every decoder in ril_binder_radio.c,
+ * i.e. the arguments of IRadioResponse and IRadioIndication calls
+ * following RadioResponseInfo or RadioIndicationType. Each payload
+ * comes in three sizes, so that the same code can be used for
+ * unit tests and benchmarks.
+ */
+
+#include <gbinder.h>
+
+typedef enum test_parcel_size {
+    TEST_PARCEL_SMALL,      /* Single element lists, empty strings */
+    TEST_PARCEL_TYPICAL,    /* What a phone normally sees */
+    TEST_PARCEL_WORST,      /* Long lists, long strings */
+    TEST_PARCEL_SIZE_COUNT
+} TEST_PARCEL_SIZE;
+
+/* Longest free text string in the worst case */
+#define TEST_PARCEL_MAX_TEXT (255)
+
+typedef struct test_parcel TestParcel;
+
+typedef
+void
+(*TestParcelBuildFunc)(
+    TestParcel* parcel,
+    TEST_PARCEL_SIZE size);
+
+typedef struct test_parcel_type {
+    const char* name;   /* ril_binder_radio_decode_ suffix */
+    TestParcelBuildFunc build;
+} TestParcelType;
+
+const TestParcelType*
+test_parcel_types(
+    guint* count);
+
+const TestParcelType*
+test_parcel_type_find(
+    const char* name);
+
+const char*
+test_parcel_size_name(
+    TEST_PARCEL_SIZE size);
+
+/* The request owns all the memory the payload refers to */
+GBinderLocalRequest*
+test_parcel_new(
+    const TestParcelType* type,
+    TEST_PARCEL_SIZE size);
+
+#endif /* TEST_PARCELS_H */
+
+/*
+ * Local Variables:
+ * mode: C
+ * c-basic-offset: 4
+ * indent-tabs-mode: nil
+ * End:
+ */
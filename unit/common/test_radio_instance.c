@@ -0,0 +1,919 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_radio_instance.h"
+#include "test_gbinder.h"
+
+#include <string.h>
+
+typedef enum test_radio_handler_type {
+    TEST_RADIO_HANDLER_INDICATION,
+    TEST_RADIO_HANDLER_RESPONSE,
+    TEST_RADIO_HANDLER_ACK,
+    TEST_RADIO_HANDLER_DEATH
+} TEST_RADIO_HANDLER_TYPE;
+
+typedef struct test_radio_handler {
+    gulong id;
+    TEST_RADIO_HANDLER_TYPE type;
+    guint code;
+    GCallback func;
+    gpointer user_data;
+} TestRadioHandler;
+
+typedef struct test_radio_instance {
+    RadioInstance pub;
+    GMutex mutex;   /* Protects the fields up to the empty line */
+    GRand* rand;
+    guint delay_ms;
+    guint jitter_ms;
+    guint fail_count;
+    gboolean record;
+    GArray* tx;
+    GHashTable* script;
+    GSList* pending;
+
+    GArray* handlers;
+    gulong last_handler_id;
+    GSList* storms;
+    gboolean enabled;
+    gboolean dead;
+    guint acks;
+} TestRadioInstance;
+
+typedef struct test_radio_delivery {
+    TestRadioInstance* self;
+    TestRadioResponse resp;
+    guint32 serial;
+    guint id;
+} TestRadioDelivery;
+
+typedef struct test_radio_storm_run {
+    TestRadioInstance* self;
+    TestRadioStorm storm;
+    GDestroyNotify done;
+    gpointer user_data;
+    guint remaining;
+    guint id;
+} TestRadioStormRun;
+
+typedef GObjectClass TestRadioInstanceClass;
+G_DEFINE_TYPE(TestRadioInstance, test_radio_instance, G_TYPE_OBJECT)
+#define TEST_TYPE_RADIO_INSTANCE (test_radio_instance_get_type())
+#define TEST_RADIO_INSTANCE(obj) G_TYPE_CHECK_INSTANCE_CAST(obj, \
+        TEST_TYPE_RADIO_INSTANCE, TestRadioInstance)
+#define PARENT_CLASS test_radio_instance_parent_class
+
+#define TEST_RADIO_DEFAULT_SEED (1234)
+
+static TestRadioInstance* test_radio_instance_last_instance;
+
+/*==========================================================================*
+ * Implementation
+ *==========================================================================*/
+
+static
+guint
+test_radio_instance_next_delay(
+    TestRadioInstance* self,
+    guint base_ms)
+{
+    guint ms = base_ms;
+
+    g_mutex_lock(&self->mutex);
+    if (self->jitter_ms) {
+        ms += g_rand_int_range(self->rand, 0, self->jitter_ms + 1);
+    }
+    g_mutex_unlock(&self->mutex);
+    return ms;
+}
+
+static
+guint
+test_radio_instance_add_handler(
+    TestRadioInstance* self,
+    TEST_RADIO_HANDLER_TYPE type,
+    guint code,
+    GCallback func,
+    gpointer user_data)
+{
+    TestRadioHandler handler;
+
+    handler.id = ++(self->last_handler_id);
+    handler.type = type;
+    handler.code = code;
+    handler.func = func;
+    handler.user_data = user_data;
+    g_array_append_val(self->handlers, handler);
+    return handler.id;
+}
+
+static
+gboolean
+test_radio_instance_find_handler(
+    TestRadioInstance* self,
+    gulong id,
+    TestRadioHandler* out)
+{
+    guint i;
+
+    for (i = 0; i < self->handlers->len; i++) {
+        const TestRadioHandler* handler = &g_array_index(self->handlers,
+            TestRadioHandler, i);
+
+        if (handler->id == id) {
+            *out = *handler;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/*
+ * Handlers may remove themselves (or each other) while being invoked,
+ * hence the lookup by id before each call.
+ */
+static
+gulong*
+test_radio_instance_handler_ids(
+    TestRadioInstance* self,
+    TEST_RADIO_HANDLER_TYPE type,
+    guint* count)
+{
+    gulong* ids = g_new(gulong, self->handlers->len + 1);
+    guint i, n = 0;
+
+    for (i = 0; i < self->handlers->len; i++) {
+        const TestRadioHandler* handler = &g_array_index(self->handlers,
+            TestRadioHandler, i);
+
+        if (handler->type == type) {
+            ids[n++] = handler->id;
+        }
+    }
+    *count = n;
+    return ids;
+}
+
+static
+gboolean
+test_radio_instance_dispatch_indication(
+    TestRadioInstance* self,
+    RADIO_IND code,
+    RADIO_IND_TYPE type,
+    GBinderLocalRequest* args)
+{
+    gboolean handled = FALSE;
+    guint i, n;
+    gulong* ids = test_radio_instance_handler_ids(self,
+        TEST_RADIO_HANDLER_INDICATION, &n);
+
+    g_object_ref(self);
+    for (i = 0; i < n && !handled; i++) {
+        TestRadioHandler h;
+
+        if (test_radio_instance_find_handler(self, ids[i], &h) &&
+            (h.code == RADIO_IND_ANY || h.code == code)) {
+            GBinderReader reader;
+
+            test_gbinder_reader_init(&reader, args);
+            handled = ((RadioIndicationHandlerFunc)h.func)(&self->pub, code,
+                type, &reader, h.user_data);
+        }
+    }
+    g_object_unref(self);
+    g_free(ids);
+    return handled;
+}
+
+static
+gboolean
+test_radio_instance_dispatch_response(
+    TestRadioInstance* self,
+    RADIO_RESP code,
+    const RadioResponseInfo* info,
+    GBinderLocalRequest* args)
+{
+    gboolean handled = FALSE;
+    guint i, n;
+    gulong* ids = test_radio_instance_handler_ids(self,
+        TEST_RADIO_HANDLER_RESPONSE, &n);
+
+    g_object_ref(self);
+    for (i = 0; i < n && !handled; i++) {
+        TestRadioHandler h;
+
+        if (test_radio_instance_find_handler(self, ids[i], &h) &&
+            (h.code == RADIO_RESP_ANY || h.code == code)) {
+            GBinderReader reader;
+
+            test_gbinder_reader_init(&reader, args);
+            handled = ((RadioResponseHandlerFunc)h.func)(&self->pub, code,
+                info, &reader, h.user_data);
+        }
+    }
+    g_object_unref(self);
+    g_free(ids);
+    return handled;
+}
+
+static
+GBinderLocalRequest*
+test_radio_instance_build(
+    TestRadioWriteFunc write,
+    gpointer user_data)
+{
+    GBinderLocalRequest* args = test_gbinder_local_request_new();
+
+    if (write) {
+        GBinderWriter writer;
+
+        gbinder_local_request_init_writer(args, &writer);
+        write(&writer, user_data);
+    }
+    return args;
+}
+
+static
+gboolean
+test_radio_instance_deliver(
+    gpointer user_data)
+{
+    TestRadioDelivery* delivery = user_data;
+    TestRadioInstance* self = delivery->self;
+    const TestRadioResponse* resp = &delivery->resp;
+    GBinderLocalRequest* args = test_radio_instance_build(resp->write,
+        resp->user_data);
+    RadioResponseInfo info;
+
+    g_mutex_lock(&self->mutex);
+    self->pending = g_slist_remove(self->pending, delivery);
+    g_mutex_unlock(&self->mutex);
+
+    memset(&info, 0, sizeof(info));
+    info.type = resp->type;
+    info.serial = delivery->serial;
+    info.error = resp->error;
+    test_radio_instance_dispatch_response(self, resp->resp, &info, args);
+    gbinder_local_request_unref(args);
+    return G_SOURCE_REMOVE;
+}
+
+static
+void
+test_radio_instance_delivery_free(
+    gpointer user_data)
+{
+    TestRadioDelivery* delivery = user_data;
+
+    g_object_unref(delivery->self);
+    g_slice_free(TestRadioDelivery, delivery);
+}
+
+/* Called with the mutex locked */
+static
+void
+test_radio_instance_schedule(
+    TestRadioInstance* self,
+    const TestRadioResponse* resp,
+    guint32 serial)
+{
+    TestRadioDelivery* delivery = g_slice_new0(TestRadioDelivery);
+    guint ms = self->delay_ms;
+
+    if (self->jitter_ms) {
+        ms += g_rand_int_range(self->rand, 0, self->jitter_ms + 1);
+    }
+    delivery->self = g_object_ref(self);
+    delivery->resp = *resp;
+    delivery->serial = serial;
+    self->pending = g_slist_append(self->pending, delivery);
+    delivery->id = g_timeout_add_full(G_PRIORITY_DEFAULT, ms,
+        test_radio_instance_deliver, delivery,
+        test_radio_instance_delivery_free);
+}
+
+static
+void
+test_radio_instance_cancel_pending(
+    TestRadioInstance* self)
+{
+    GSList* pending;
+
+    g_mutex_lock(&self->mutex);
+    pending = self->pending;
+    self->pending = NULL;
+    g_mutex_unlock(&self->mutex);
+
+    while (pending) {
+        TestRadioDelivery* delivery = pending->data;
+
+        pending = g_slist_delete_link(pending, pending);
+        g_source_remove(delivery->id);
+    }
+}
+
+static
+gboolean
+test_radio_instance_storm_next(
+    gpointer user_data);
+
+static
+void
+test_radio_instance_storm_schedule(
+    TestRadioStormRun* run)
+{
+    const guint interval = run->storm.interval_ms;
+
+    run->id = interval ?
+        g_timeout_add(test_radio_instance_next_delay(run->self, interval),
+            test_radio_instance_storm_next, run) :
+        g_idle_add(test_radio_instance_storm_next, run);
+}
+
+static
+void
+test_radio_instance_storm_finish(
+    TestRadioStormRun* run)
+{
+    TestRadioInstance* self = run->self;
+
+    self->storms = g_slist_remove(self->storms, run);
+    if (run->id) {
+        g_source_remove(run->id);
+    }
+    if (run->done) {
+        run->done(run->user_data);
+    }
+    g_slice_free(TestRadioStormRun, run);
+    g_object_unref(self);
+}
+
+static
+gboolean
+test_radio_instance_storm_next(
+    gpointer user_data)
+{
+    TestRadioStormRun* run = user_data;
+    const TestRadioStorm* storm = &run->storm;
+    GBinderLocalRequest* args = test_radio_instance_build(storm->write,
+        storm->user_data);
+
+    run->id = 0;
+    run->remaining--;
+    test_radio_instance_dispatch_indication(run->self, storm->code,
+        storm->type, args);
+    gbinder_local_request_unref(args);
+    if (run->remaining && !run->self->dead) {
+        test_radio_instance_storm_schedule(run);
+    } else {
+        test_radio_instance_storm_finish(run);
+    }
+    return G_SOURCE_REMOVE;
+}
+
+static
+void
+test_radio_instance_cancel_storms(
+    TestRadioInstance* self)
+{
+    while (self->storms) {
+        test_radio_instance_storm_finish(self->storms->data);
+    }
+}
+
+static
+void
+test_radio_instance_tx_free(
+    gpointer data)
+{
+    g_bytes_unref(((TestRadioTx*)data)->dump);
+}
+
+/*==========================================================================*
+ * RadioInstance API
+ *==========================================================================*/
+
+RadioInstance*
+radio_instance_new_with_version(
+    const char* dev,
+    const char* name,
+    RADIO_INTERFACE version)
+{
+    TestRadioInstance* self = g_object_new(TEST_TYPE_RADIO_INSTANCE, NULL);
+
+    self->pub.version = version;
+    test_radio_instance_last_instance = self;
+    return &self->pub;
+}
+
+RadioInstance*
+radio_instance_ref(
+    RadioInstance* radio)
+{
+    if (radio) {
+        g_object_ref(TEST_RADIO_INSTANCE(radio));
+    }
+    return radio;
+}
+
+void
+radio_instance_unref(
+    RadioInstance* radio)
+{
+    if (radio) {
+        g_object_unref(TEST_RADIO_INSTANCE(radio));
+    }
+}
+
+gboolean
+radio_instance_ack(
+    RadioInstance* radio)
+{
+    if (radio) {
+        TestRadioInstance* self = TEST_RADIO_INSTANCE(radio);
+
+        self->acks++;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+GBinderLocalRequest*
+radio_instance_new_request(
+    RadioInstance* radio,
+    RADIO_REQ code)
+{
+    return radio ? test_gbinder_local_request_new() : NULL;
+}
+
+gboolean
+radio_instance_send_request_sync(
+    RadioInstance* radio,
+    RADIO_REQ code,
+    GBinderLocalRequest* args)
+{
+    gboolean ok = FALSE;
+
+    if (radio && args) {
+        TestRadioInstance* self = TEST_RADIO_INSTANCE(radio);
+        GBinderReader reader;
+        guint32 serial = 0;
+
+        /* Serial is the first argument of every IRadio request */
+        test_gbinder_reader_init(&reader, args);
+        gbinder_reader_read_uint32(&reader, &serial);
+
+        g_mutex_lock(&self->mutex);
+        if (self->fail_count) {
+            self->fail_count--;
+        } else if (!self->dead) {
+            const TestRadioResponse* resp =
+                g_hash_table_lookup(self->script, GINT_TO_POINTER(code));
+
+            if (self->record) {
+                TestRadioTx tx;
+
+                tx.code = code;
+                tx.serial = serial;
+                tx.dump = test_gbinder_local_request_dump(args);
+                g_array_append_val(self->tx, tx);
+            }
+            if (resp) {
+                test_radio_instance_schedule(self, resp, serial);
+            }
+            ok = TRUE;
+        }
+        g_mutex_unlock(&self->mutex);
+    }
+    return ok;
+}
+
+void
+radio_instance_set_enabled(
+    RadioInstance* radio,
+    gboolean enabled)
+{
+    if (radio) {
+        TEST_RADIO_INSTANCE(radio)->enabled = enabled;
+    }
+}
+
+gulong
+radio_instance_add_indication_handler(
+    RadioInstance* radio,
+    RADIO_IND code,
+    RadioIndicationHandlerFunc func,
+    gpointer user_data)
+{
+    return (radio && func) ?
+        test_radio_instance_add_handler(TEST_RADIO_INSTANCE(radio),
+            TEST_RADIO_HANDLER_INDICATION, code, G_CALLBACK(func),
+            user_data) : 0;
+}
+
+gulong
+radio_instance_add_response_handler(
+    RadioInstance* radio,
+    RADIO_RESP code,
+    RadioResponseHandlerFunc func,
+    gpointer user_data)
+{
+    return (radio && func) ?
+        test_radio_instance_add_handler(TEST_RADIO_INSTANCE(radio),
+            TEST_RADIO_HANDLER_RESPONSE, code, G_CALLBACK(func),
+            user_data) : 0;
+}
+
+gulong
+radio_instance_add_ack_handler(
+    RadioInstance* radio,
+    RadioAckFunc func,
+    gpointer user_data)
+{
+    return (radio && func) ?
+        test_radio_instance_add_handler(TEST_RADIO_INSTANCE(radio),
+            TEST_RADIO_HANDLER_ACK, 0, G_CALLBACK(func), user_data) : 0;
+}
+
+gulong
+radio_instance_add_death_handler(
+    RadioInstance* radio,
+    RadioInstanceFunc func,
+    gpointer user_data)
+{
+    return (radio && func) ?
+        test_radio_instance_add_handler(TEST_RADIO_INSTANCE(radio),
+            TEST_RADIO_HANDLER_DEATH, 0, G_CALLBACK(func), user_data) : 0;
+}
+
+void
+radio_instance_remove_handlers(
+    RadioInstance* radio,
+    gulong* ids,
+    int count)
+{
+    if (radio && ids) {
+        TestRadioInstance* self = TEST_RADIO_INSTANCE(radio);
+        int i;
+
+        for (i = 0; i < count; i++) {
+            if (ids[i]) {
+                guint k;
+
+                for (k = 0; k < self->handlers->len; k++) {
+                    if (g_array_index(self->handlers, TestRadioHandler,
+                        k).id == ids[i]) {
+                        g_array_remove_index(self->handlers, k);
+                        break;
+                    }
+                }
+                ids[i] = 0;
+            }
+        }
+    }
+}
+
+/*==========================================================================*
+ * Test API
+ *==========================================================================*/
+
+RadioInstance*
+test_radio_instance_last(
+    void)
+{
+    return test_radio_instance_last_instance ?
+        &test_radio_instance_last_instance->pub : NULL;
+}
+
+void
+test_radio_instance_set_delay(
+    RadioInstance* radio,
+    guint delay_ms,
+    guint jitter_ms)
+{
+    TestRadioInstance* self = TEST_RADIO_INSTANCE(radio);
+
+    g_mutex_lock(&self->mutex);
+    self->delay_ms = delay_ms;
+    self->jitter_ms = jitter_ms;
+    g_mutex_unlock(&self->mutex);
+}
+
+void
+test_radio_instance_set_seed(
+    RadioInstance* radio,
+    guint32 seed)
+{
+    TestRadioInstance* self = TEST_RADIO_INSTANCE(radio);
+
+    g_mutex_lock(&self->mutex);
+    g_rand_set_seed(self->rand, seed);
+    g_mutex_unlock(&self->mutex);
+}
+
+void
+test_radio_instance_set_record(
+    RadioInstance* radio,
+    gboolean record)
+{
+    TestRadioInstance* self = TEST_RADIO_INSTANCE(radio);
+
+    g_mutex_lock(&self->mutex);
+    self->record = record;
+    g_mutex_unlock(&self->mutex);
+}
+
+void
+test_radio_instance_script(
+    RadioInstance* radio,
+    const TestRadioResponse* responses,
+    guint count)
+{
+    TestRadioInstance* self = TEST_RADIO_INSTANCE(radio);
+    guint i;
+
+    g_mutex_lock(&self->mutex);
+    for (i = 0; i < count; i++) {
+        const TestRadioResponse* resp = responses + i;
+
+        g_hash_table_replace(self->script, GINT_TO_POINTER(resp->req),
+            g_slice_dup(TestRadioResponse, resp));
+    }
+    g_mutex_unlock(&self->mutex);
+}
+
+void
+test_radio_instance_fail_requests(
+    RadioInstance* radio,
+    guint count)
+{
+    TestRadioInstance* self = TEST_RADIO_INSTANCE(radio);
+
+    g_mutex_lock(&self->mutex);
+    self->fail_count = count;
+    g_mutex_unlock(&self->mutex);
+}
+
+void
+test_radio_instance_storm(
+    RadioInstance* radio,
+    const TestRadioStorm* storm,
+    GDestroyNotify done,
+    gpointer user_data)
+{
+    TestRadioInstance* self = TEST_RADIO_INSTANCE(radio);
+    TestRadioStormRun* run = g_slice_new0(TestRadioStormRun);
+
+    run->self = g_object_ref(self);
+    run->storm = *storm;
+    run->done = done;
+    run->user_data = user_data;
+    run->remaining = storm->count;
+    self->storms = g_slist_append(self->storms, run);
+    if (run->remaining) {
+        test_radio_instance_storm_schedule(run);
+    } else {
+        test_radio_instance_storm_finish(run);
+    }
+}
+
+gboolean
+test_radio_instance_indicate(
+    RadioInstance* radio,
+    RADIO_IND code,
+    RADIO_IND_TYPE type,
+    GBinderLocalRequest* args)
+{
+    return test_radio_instance_dispatch_indication
+        (TEST_RADIO_INSTANCE(radio), code, type, args);
+}
+
+gboolean
+test_radio_instance_respond(
+    RadioInstance* radio,
+    RADIO_RESP code,
+    const RadioResponseInfo* info,
+    GBinderLocalRequest* args)
+{
+    return test_radio_instance_dispatch_response
+        (TEST_RADIO_INSTANCE(radio), code, info, args);
+}
+
+void
+test_radio_instance_ack_request(
+    RadioInstance* radio,
+    guint32 serial)
+{
+    TestRadioInstance* self = TEST_RADIO_INSTANCE(radio);
+    guint i, n;
+    gulong* ids = test_radio_instance_handler_ids(self,
+        TEST_RADIO_HANDLER_ACK, &n);
+
+    g_object_ref(self);
+    for (i = 0; i < n; i++) {
+        TestRadioHandler h;
+
+        if (test_radio_instance_find_handler(self, ids[i], &h)) {
+            ((RadioAckFunc)h.func)(radio, serial, h.user_data);
+        }
+    }
+    g_object_unref(self);
+    g_free(ids);
+}
+
+void
+test_radio_instance_connect(
+    RadioInstance* radio)
+{
+    GBinderLocalRequest* args = test_gbinder_local_request_new();
+
+    test_radio_instance_indicate(radio, RADIO_IND_RIL_CONNECTED,
+        RADIO_IND_UNSOLICITED, args);
+    gbinder_local_request_unref(args);
+}
+
+void
+test_radio_instance_die(
+    RadioInstance* radio)
+{
+    TestRadioInstance* self = TEST_RADIO_INSTANCE(radio);
+    guint i, n;
+    gulong* ids;
+
+    g_object_ref(self);
+    g_mutex_lock(&self->mutex);
+    self->dead = TRUE;
+    g_mutex_unlock(&self->mutex);
+    test_radio_instance_cancel_pending(self);
+    test_radio_instance_cancel_storms(self);
+    ids = test_radio_instance_handler_ids(self, TEST_RADIO_HANDLER_DEATH,
+        &n);
+    for (i = 0; i < n; i++) {
+        TestRadioHandler h;
+
+        if (test_radio_instance_find_handler(self, ids[i], &h)) {
+            ((RadioInstanceFunc)h.func)(radio, h.user_data);
+        }
+    }
+    g_free(ids);
+    g_object_unref(self);
+}
+
+guint
+test_radio_instance_tx_count(
+    RadioInstance* radio)
+{
+    TestRadioInstance* self = TEST_RADIO_INSTANCE(radio);
+    guint count;
+
+    g_mutex_lock(&self->mutex);
+    count = self->tx->len;
+    g_mutex_unlock(&self->mutex);
+    return count;
+}
+
+const TestRadioTx*
+test_radio_instance_tx(
+    RadioInstance* radio,
+    guint i)
+{
+    TestRadioInstance* self = TEST_RADIO_INSTANCE(radio);
+    const TestRadioTx* tx = NULL;
+
+    g_mutex_lock(&self->mutex);
+    if (i < self->tx->len) {
+        tx = &g_array_index(self->tx, TestRadioTx, i);
+    }
+    g_mutex_unlock(&self->mutex);
+    return tx;
+}
+
+void
+test_radio_instance_tx_clear(
+    RadioInstance* radio)
+{
+    TestRadioInstance* self = TEST_RADIO_INSTANCE(radio);
+
+    g_mutex_lock(&self->mutex);
+    g_array_set_size(self->tx, 0);
+    g_mutex_unlock(&self->mutex);
+}
+
+guint
+test_radio_instance_pending(
+    RadioInstance* radio)
+{
+    TestRadioInstance* self = TEST_RADIO_INSTANCE(radio);
+    guint count;
+
+    g_mutex_lock(&self->mutex);
+    count = g_slist_length(self->pending);
+    g_mutex_unlock(&self->mutex);
+    return count;
+}
+
+guint
+test_radio_instance_acks(
+    RadioInstance* radio)
+{
+    return TEST_RADIO_INSTANCE(radio)->acks;
+}
+
+gboolean
+test_radio_instance_enabled(
+    RadioInstance* radio)
+{
+    return TEST_RADIO_INSTANCE(radio)->enabled;
+}
+
+/*==========================================================================*
+ * Internals
+ *==========================================================================*/
+
+static
+void
+test_radio_instance_response_free(
+    gpointer data)
+{
+    g_slice_free(TestRadioResponse, data);
+}
+
+static
+void
+test_radio_instance_init(
+    TestRadioInstance* self)
+{
+    g_mutex_init(&self->mutex);
+    self->rand = g_rand_new_with_seed(TEST_RADIO_DEFAULT_SEED);
+    self->record = TRUE;
+    self->tx = g_array_new(FALSE, FALSE, sizeof(TestRadioTx));
+    g_array_set_clear_func(self->tx, test_radio_instance_tx_free);
+    self->script = g_hash_table_new_full(g_direct_hash, g_direct_equal,
+        NULL, test_radio_instance_response_free);
+    self->handlers = g_array_new(FALSE, FALSE, sizeof(TestRadioHandler));
+}
+
+static
+void
+test_radio_instance_finalize(
+    GObject* object)
+{
+    TestRadioInstance* self = TEST_RADIO_INSTANCE(object);
+
+    /* Pending deliveries and storms hold references */
+    g_assert(!self->pending);
+    if (test_radio_instance_last_instance == self) {
+        test_radio_instance_last_instance = NULL;
+    }
+    g_array_free(self->handlers, TRUE);
+    g_hash_table_destroy(self->script);
+    g_array_free(self->tx, TRUE);
+    g_rand_free(self->rand);
+    g_mutex_clear(&self->mutex);
+    G_OBJECT_CLASS(PARENT_CLASS)->finalize(object);
+}
+
+static
+void
+test_radio_instance_class_init(
+    TestRadioInstanceClass* klass)
+{
+    klass->finalize = test_radio_instance_finalize;
+}
+
+/*
+ * Local Variables:
+ * mode: C
+ * c-basic-offset: 4
+ * indent-tabs-mode: nil
+ * End:
+ */
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TEST_RADIO_INSTANCE_H
+#define TEST_RADIO_INSTANCE_H
+
+/*
+ * Loopback RadioInstance, linked into the test binaries instead of
+ * libgbinder-radio. Requests submitted by the transport are logged and
+ * answered with scripted IRadioResponse transactions, after a delay with
+ * optional (seeded, hence reproducible) jitter. Indications can be sent
+ * one by one or as timed storms. Everything gets delivered on the main
+ * thread, requests may come from any thread.
+ */
+
+#include <radio_instance.h>
+
+typedef struct test_radio_tx {
+    RADIO_REQ code;
+    guint32 serial;
+    GBytes* dump;   /* See test_gbinder_local_request_dump() */
+} TestRadioTx;
+
+typedef
+void
+(*TestRadioWriteFunc)(
+    GBinderWriter* writer,
+    gpointer user_data);
+
+/* Response to the request with the matching code */
+typedef struct test_radio_response {
+    RADIO_REQ req;
+    RADIO_RESP resp;
+    RADIO_RESP_TYPE type;
+    RADIO_ERROR error;
+    TestRadioWriteFunc write;   /* Writes the arguments, may be NULL */
+    gpointer user_data;
+} TestRadioResponse;
+
+/* Series of identical indications */
+typedef struct test_radio_storm {
+    RADIO_IND code;
+    RADIO_IND_TYPE type;
+    TestRadioWriteFunc write;
+    gpointer user_data;
+    guint count;
+    guint interval_ms;          /* Zero means one per loop iteration */
+} TestRadioStorm;
+
+/* The last instance created by the transport (not referenced) */
+RadioInstance*
+test_radio_instance_last(
+    void);
+
+void
+test_radio_instance_set_delay(
+    RadioInstance* radio,
+    guint delay_ms,
+    guint jitter_ms);
+
+void
+test_radio_instance_set_seed(
+    RadioInstance* radio,
+    guint32 seed);
+
+/* Requests are logged by default, benchmarks turn it off */
+void
+test_radio_instance_set_record(
+    RadioInstance* radio,
+    gboolean record);
+
+/* Replaces the previous response to the same request */
+void
+test_radio_instance_script(
+    RadioInstance* radio,
+    const TestRadioResponse* responses,
+    guint count);
+
+/* The next count requests fail to submit */
+void
+test_radio_instance_fail_requests(
+    RadioInstance* radio,
+    guint count);
+
+void
+test_radio_instance_storm(
+    RadioInstance* radio,
+    const TestRadioStorm* storm,
+    GDestroyNotify done,
+    gpointer user_data);
+
+/* Synchronous delivery, returns what the handler returned */
+gboolean
+test_radio_instance_indicate(
+    RadioInstance* radio,
+    RADIO_IND code,
+    RADIO_IND_TYPE type,
+    GBinderLocalRequest* args);
+
+gboolean
+test_radio_instance_respond(
+    RadioInstance* radio,
+    RADIO_RESP code,
+    const RadioResponseInfo* info,
+    GBinderLocalRequest* args);
+
+/* IRadioResponse.acknowledgeRequest */
+void
+test_radio_instance_ack_request(
+    RadioInstance* radio,
+    guint32 serial);
+
+/* IRadioIndication.rilConnected */
+void
+test_radio_instance_connect(
+    RadioInstance* radio);
+
+void
+test_radio_instance_die(
+    RadioInstance* radio);
+
+guint
+test_radio_instance_tx_count(
+    RadioInstance* radio);
+
+/* Valid until test_radio_instance_tx_clear() */
+const TestRadioTx*
+test_radio_instance_tx(
+    RadioInstance* radio,
+    guint i);
+
+void
+test_radio_instance_tx_clear(
+    RadioInstance* radio);
+
+/* Scheduled responses not delivered yet */
+guint
+test_radio_instance_pending(
+    RadioInstance* radio);
+
+/* Number of radio_instance_ack() calls */
+guint
+test_radio_instance_acks(
+    RadioInstance* radio);
+
+gboolean
+test_radio_instance_enabled(
+    RadioInstance* radio);
+
+#endif /* TEST_RADIO_INSTANCE_H */
+
+/*
+ * Local Variables:
+ * mode: C
+ * c-basic-offset: 4
+ * indent-tabs-mode: nil
+ * End:
+ */
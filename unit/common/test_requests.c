@@ -0,0 +1,539 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_requests.h"
+
+#include <string.h>
+
+#define TEST_REQUEST_MAX_HEX_BYTES (256)
+
+/*==========================================================================*
+ * Helpers
+ *==========================================================================*/
+
+static
+guint
+test_request_count(
+    TEST_PARCEL_SIZE size,
+    guint typical,
+    guint worst)
+{
+    switch (size) {
+    case TEST_PARCEL_TYPICAL:
+        return typical;
+    case TEST_PARCEL_WORST:
+        return worst;
+    default:
+        return 1;
+    }
+}
+
+/* Free text, e.g. APN or user name */
+static
+void
+test_request_append_text(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size,
+    const char* typical)
+{
+    char text[TEST_PARCEL_MAX_TEXT + 1];
+
+    switch (size) {
+    case TEST_PARCEL_TYPICAL:
+        grilio_request_append_utf8(req, typical);
+        break;
+    case TEST_PARCEL_WORST:
+        memset(text, 'W', TEST_PARCEL_MAX_TEXT);
+        text[TEST_PARCEL_MAX_TEXT] = 0;
+        grilio_request_append_utf8(req, text);
+        break;
+    default:
+        grilio_request_append_utf8(req, "");
+        break;
+    }
+}
+
+static
+void
+test_request_append_hex(
+    GRilIoRequest* req,
+    guint nbytes)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    char str[2 * TEST_REQUEST_MAX_HEX_BYTES + 1];
+    guint i;
+
+    nbytes = MIN(nbytes, TEST_REQUEST_MAX_HEX_BYTES);
+    for (i = 0; i < 2 * nbytes; i++) {
+        str[i] = hex[i % 16];
+    }
+    str[i] = 0;
+    grilio_request_append_utf8(req, str);
+}
+
+/*==========================================================================*
+ * Generic
+ *==========================================================================*/
+
+static
+void
+test_request_build_serial(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    /* Nothing but the serial */
+}
+
+static
+void
+test_request_build_int(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    grilio_request_append_int32(req, 1);
+}
+
+static
+void
+test_request_build_bool(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    grilio_request_append_int32(req, 1);
+    grilio_request_append_int32(req, TRUE);
+}
+
+static
+void
+test_request_build_ints(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    const guint n = test_request_count(size, 2, 16);
+    guint i;
+
+    grilio_request_append_int32(req, n);
+    for (i = 0; i < n; i++) {
+        grilio_request_append_int32(req, i + 1);
+    }
+}
+
+static
+void
+test_request_build_string(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    test_request_append_text(req, size, "*100#");
+}
+
+static
+void
+test_request_build_strings(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    const guint n = test_request_count(size, 2, 8);
+    guint i;
+
+    grilio_request_append_int32(req, n);
+    for (i = 0; i < n; i++) {
+        test_request_append_text(req, size, "1234");
+    }
+}
+
+static
+void
+test_request_build_ints_to_bool_int(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    grilio_request_append_int32(req, 2);
+    grilio_request_append_int32(req, TRUE);
+    grilio_request_append_int32(req, 1);
+}
+
+static
+void
+test_request_build_device_state(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    grilio_request_append_int32(req, 2);
+    grilio_request_append_int32(req, 1);
+    grilio_request_append_int32(req, TRUE);
+}
+
+static
+void
+test_request_build_screen_state(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    grilio_request_append_int32(req, 1);
+    grilio_request_append_int32(req, 0);
+}
+
+/*==========================================================================*
+ * Calls and supplementary services
+ *==========================================================================*/
+
+static
+void
+test_request_build_dial(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    grilio_request_append_utf8(req, (size == TEST_PARCEL_WORST) ?
+        "+358401234567,,,1234#,,,5678#,,,90123456789012345678#" :
+        "+358401234567");
+    grilio_request_append_int32(req, 0);    /* clir */
+    grilio_request_append_int32(req, 0);    /* UUS information */
+}
+
+static
+void
+test_request_build_call_forward_info(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    grilio_request_append_int32(req, 3);    /* status */
+    grilio_request_append_int32(req, 0);    /* reason */
+    grilio_request_append_int32(req, 1);    /* serviceClass */
+    grilio_request_append_int32(req, 145);  /* toa */
+    grilio_request_append_utf8(req, "+358401234567");
+    grilio_request_append_int32(req, 20);   /* timeSeconds */
+}
+
+static
+void
+test_request_build_get_facility_lock(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    grilio_request_append_int32(req, 4);
+    grilio_request_append_utf8(req, "SC");
+    grilio_request_append_utf8(req, "");
+    grilio_request_append_utf8(req, "7");
+    test_request_append_text(req, size, "A0000000871002FF49FF0589");
+}
+
+static
+void
+test_request_build_set_facility_lock(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    grilio_request_append_int32(req, 5);
+    grilio_request_append_utf8(req, "SC");
+    grilio_request_append_utf8(req, "1");
+    grilio_request_append_utf8(req, "1234");
+    grilio_request_append_utf8(req, "7");
+    test_request_append_text(req, size, "A0000000871002FF49FF0589");
+}
+
+/*==========================================================================*
+ * SMS
+ *==========================================================================*/
+
+static
+void
+test_request_build_gsm_sms_message(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    grilio_request_append_int32(req, 2);
+    if (size == TEST_PARCEL_SMALL) {
+        grilio_request_append_utf8(req, NULL);
+    } else {
+        grilio_request_append_utf8(req, "07915348150110F0");
+    }
+    test_request_append_hex(req, test_request_count(size, 40, 176));
+}
+
+static
+void
+test_request_build_sms_write_args(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    grilio_request_append_int32(req, 1);
+    test_request_append_hex(req, test_request_count(size, 40, 176));
+    grilio_request_append_utf8(req, "07915348150110F0");
+}
+
+static
+void
+test_request_build_gsm_broadcast_sms_config(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    const guint n = test_request_count(size, 4, 32);
+    guint i;
+
+    grilio_request_append_int32(req, n);
+    for (i = 0; i < n; i++) {
+        grilio_request_append_int32(req, 4352 + 2 * i);
+        grilio_request_append_int32(req, 4353 + 2 * i);
+        grilio_request_append_int32(req, 0);
+        grilio_request_append_int32(req, 255);
+        grilio_request_append_int32(req, TRUE);
+    }
+}
+
+/*==========================================================================*
+ * SIM
+ *==========================================================================*/
+
+static
+void
+test_request_build_icc_io(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    grilio_request_append_int32(req, (size == TEST_PARCEL_SMALL) ?
+        0xc0 : 0xdc);                       /* GET RESPONSE, UPDATE RECORD */
+    grilio_request_append_int32(req, 0x6f3c);
+    grilio_request_append_utf8(req, "3F007F10");
+    grilio_request_append_int32(req, 1);
+    grilio_request_append_int32(req, 4);
+    grilio_request_append_int32(req, test_request_count(size, 176, 255));
+    if (size == TEST_PARCEL_SMALL) {
+        grilio_request_append_utf8(req, NULL);
+    } else {
+        test_request_append_hex(req, test_request_count(size, 176, 255));
+    }
+    grilio_request_append_utf8(req, NULL);  /* pin2 */
+    grilio_request_append_utf8(req, "A0000000871002FF49FF0589");
+}
+
+static
+void
+test_request_build_uicc_sub(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    grilio_request_append_int32(req, 0);
+    grilio_request_append_int32(req, 0);
+    grilio_request_append_int32(req, 0);
+    grilio_request_append_int32(req, 1);
+}
+
+static
+void
+test_request_build_icc_open_logical_channel(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    grilio_request_append_utf8(req, "A0000000871004FF49FF0589");
+    grilio_request_append_int32(req, 0);
+}
+
+static
+void
+test_request_build_icc_transmit_apdu_logical_channel(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    grilio_request_append_int32(req, 1);    /* sessionId */
+    grilio_request_append_int32(req, 0x80); /* cla */
+    grilio_request_append_int32(req, 0xca); /* instruction */
+    grilio_request_append_int32(req, 0);
+    grilio_request_append_int32(req, 0);
+    grilio_request_append_int32(req, test_request_count(size, 32, 255));
+    test_request_append_hex(req, test_request_count(size, 32, 255));
+}
+
+/*==========================================================================*
+ * Network and data
+ *==========================================================================*/
+
+static
+void
+test_request_build_radio_capability(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    grilio_request_append_int32(req, 1);    /* version */
+    grilio_request_append_int32(req, 1);    /* session */
+    grilio_request_append_int32(req, 1);    /* phase */
+    grilio_request_append_int32(req, 0x4fff);
+    test_request_append_text(req, size, "com.example.modem.mdm0");
+    grilio_request_append_int32(req, 0);    /* status */
+}
+
+static
+void
+test_request_build_deactivate_data_call(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    grilio_request_append_int32(req, 2);
+    grilio_request_append_utf8(req, "1");
+    grilio_request_append_utf8(req, "0");
+}
+
+static
+void
+test_request_build_setup_data_call(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    grilio_request_append_int32(req, 7);
+    grilio_request_append_utf8(req, "16");  /* LTE + 2 */
+    grilio_request_append_utf8(req, "0");
+    test_request_append_text(req, size, "internet");
+    test_request_append_text(req, size, "user");
+    test_request_append_text(req, size, "password");
+    grilio_request_append_utf8(req, "3");
+    grilio_request_append_utf8(req, "IPV4V6");
+}
+
+static
+void
+test_request_build_initial_attach_apn(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    test_request_append_text(req, size, "internet");
+    grilio_request_append_utf8(req, "IPV4V6");
+    grilio_request_append_int32(req, 0);
+    if (size == TEST_PARCEL_SMALL) {
+        grilio_request_append_utf8(req, NULL);
+        grilio_request_append_utf8(req, NULL);
+    } else {
+        test_request_append_text(req, size, "user");
+        test_request_append_text(req, size, "password");
+    }
+}
+
+static
+void
+test_request_build_data_profiles(
+    GRilIoRequest* req,
+    TEST_PARCEL_SIZE size)
+{
+    const guint n = test_request_count(size, 3, 8);
+    guint i;
+
+    grilio_request_append_int32(req, n);
+    for (i = 0; i < n; i++) {
+        grilio_request_append_int32(req, i);    /* profileId */
+        test_request_append_text(req, size, "internet");
+        grilio_request_append_utf8(req, "IPV4V6");
+        grilio_request_append_int32(req, 0);    /* authType */
+        test_request_append_text(req, size, "user");
+        test_request_append_text(req, size, "password");
+        grilio_request_append_int32(req, 1);    /* type */
+        grilio_request_append_int32(req, 0);    /* maxConnsTime */
+        grilio_request_append_int32(req, 0);    /* maxConns */
+        grilio_request_append_int32(req, 0);    /* waitTime */
+        grilio_request_append_int32(req, TRUE); /* enabled */
+    }
+}
+
+/*==========================================================================*
+ * API
+ *==========================================================================*/
+
+#define TEST_REQUEST_TYPE(name) { #name, test_request_build_##name }
+#define TEST_REQUEST_TYPE_AS(name,as) { #name, test_request_build_##as }
+
+static const TestRequestType test_request_type_list[] = {
+    TEST_REQUEST_TYPE(serial),
+    TEST_REQUEST_TYPE(int),
+    TEST_REQUEST_TYPE(bool),
+    TEST_REQUEST_TYPE(ints),
+    TEST_REQUEST_TYPE(string),
+    TEST_REQUEST_TYPE(strings),
+    TEST_REQUEST_TYPE(ints_to_bool_int),
+    TEST_REQUEST_TYPE(device_state),
+    TEST_REQUEST_TYPE_AS(map_screen_state_to_device_state, screen_state),
+    TEST_REQUEST_TYPE(dial),
+    TEST_REQUEST_TYPE(call_forward_info),
+    TEST_REQUEST_TYPE(get_facility_lock),
+    TEST_REQUEST_TYPE(set_facility_lock),
+    TEST_REQUEST_TYPE(gsm_sms_message),
+    TEST_REQUEST_TYPE(sms_write_args),
+    TEST_REQUEST_TYPE(gsm_broadcast_sms_config),
+    TEST_REQUEST_TYPE(icc_io),
+    TEST_REQUEST_TYPE(uicc_sub),
+    TEST_REQUEST_TYPE(icc_open_logical_channel),
+    TEST_REQUEST_TYPE(icc_transmit_apdu_logical_channel),
+    TEST_REQUEST_TYPE(radio_capability),
+    TEST_REQUEST_TYPE(deactivate_data_call),
+    TEST_REQUEST_TYPE_AS(deactivate_data_call_1_2, deactivate_data_call),
+    TEST_REQUEST_TYPE(setup_data_call),
+    TEST_REQUEST_TYPE_AS(setup_data_call_1_2, setup_data_call),
+    TEST_REQUEST_TYPE(initial_attach_apn),
+    TEST_REQUEST_TYPE(data_profiles)
+};
+
+const TestRequestType*
+test_request_types(
+    guint* count)
+{
+    *count = G_N_ELEMENTS(test_request_type_list);
+    return test_request_type_list;
+}
+
+const TestRequestType*
+test_request_type_find(
+    const char* name)
+{
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS(test_request_type_list); i++) {
+        if (!g_strcmp0(test_request_type_list[i].name, name)) {
+            return test_request_type_list + i;
+        }
+    }
+    return NULL;
+}
+
+GRilIoRequest*
+test_request_new(
+    const TestRequestType* type,
+    TEST_PARCEL_SIZE size)
+{
+    GRilIoRequest* req = grilio_request_new();
+
+    type->build(req, size);
+    return req;
+}
+
+/*
+ * Local Variables:
+ * mode: C
+ * c-basic-offset: 4
+ * indent-tabs-mode: nil
+ * End:
+ */
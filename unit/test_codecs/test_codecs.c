@@ -0,0 +1,843 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Runs the schema driven codecs and the hand-written ones they replaced
+ * on the same inputs, including truncated and corrupted ones. Both must
+ * agree on success, and successful runs must produce the same bytes.
+ * Output of a failed run is discarded by the transport, hence isn't
+ * compared.
+ */
+
+#include "test_common.h"
+#include "test_gbinder.h"
+#include "test_parcels.h"
+#include "test_requests.h"
+
+/* Codecs are static */
+#include "ril_binder_radio.c"
+
+static TestOpt test_opt;
+
+typedef
+gboolean
+(*TestCodecsEncodeFunc)(
+    GRilIoRequest* in,
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx);
+
+typedef struct test_codecs_encoder {
+    const char* name;
+    TestCodecsEncodeFunc baseline;
+    TestCodecsEncodeFunc schema;
+} TestCodecsEncoder;
+
+typedef struct test_codecs_decoder {
+    const char* name;
+    RilBinderRadioDecodeFunc baseline;
+    RilBinderRadioDecodeFunc schema;
+} TestCodecsDecoder;
+
+/* Replacements for each 32-bit word of a valid input */
+static const gint32 test_codecs_words[] = {
+    0, 1, 2, 5, -1, -2, 0x7fffffff
+};
+
+/*==========================================================================*
+ * Baseline
+ *
+ * Hand-written codecs as they were before the schema conversion. Only
+ * the encoder context has been added, the parcel helpers need it now.
+ *==========================================================================*/
+
+static
+gboolean
+test_codecs_baseline_encode_int(
+    GRilIoRequest* in,
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
+{
+    GRilIoParser parser;
+    gint32 value;
+
+    ril_binder_radio_init_parser(&parser, in);
+    if (grilio_parser_get_int32(&parser, &value)) {
+        GBinderWriter writer;
+
+        gbinder_local_request_init_writer(out, &writer);
+        gbinder_writer_append_int32(&writer, grilio_request_serial(in));
+        gbinder_writer_append_int32(&writer, value);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static
+gboolean
+test_codecs_baseline_encode_bool(
+    GRilIoRequest* in,
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
+{
+    GRilIoParser parser;
+    gint32 count, value;
+
+    ril_binder_radio_init_parser(&parser, in);
+    if (grilio_parser_get_int32(&parser, &count) && count == 1 &&
+        grilio_parser_get_int32(&parser, &value)) {
+        GBinderWriter writer;
+
+        gbinder_local_request_init_writer(out, &writer);
+        gbinder_writer_append_int32(&writer, grilio_request_serial(in));
+        gbinder_writer_append_bool(&writer, value);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static
+gboolean
+test_codecs_baseline_encode_ints(
+    GRilIoRequest* in,
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
+{
+    GRilIoParser parser;
+    gint32 count;
+
+    ril_binder_radio_init_parser(&parser, in);
+    if (grilio_parser_get_int32(&parser, &count)) {
+        GBinderWriter writer;
+        guint i;
+
+        gbinder_local_request_init_writer(out, &writer);
+        gbinder_writer_append_int32(&writer, grilio_request_serial(in));
+        for (i = 0; i < count; i++) {
+            gint32 value;
+
+            if (grilio_parser_get_int32(&parser, &value)) {
+                gbinder_writer_append_int32(&writer, value);
+            } else {
+                return FALSE;
+            }
+        }
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static
+gboolean
+test_codecs_baseline_encode_string(
+    GRilIoRequest* in,
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
+{
+    RilBinderRadioParcel parcel;
+    const char* str;
+
+    ril_binder_radio_parcel_init(&parcel, in, ctx);
+    str = ril_binder_radio_parcel_get_str(&parcel);
+    if (str) {
+        GBinderWriter writer;
+
+        gbinder_local_request_init_writer(out, &writer);
+        gbinder_writer_append_int32(&writer, grilio_request_serial(in));
+        gbinder_writer_append_hidl_string(&writer, str);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static
+gboolean
+test_codecs_baseline_encode_strings(
+    GRilIoRequest* in,
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
+{
+    RilBinderRadioParcel parcel;
+    gint32 count;
+
+    ril_binder_radio_parcel_init(&parcel, in, ctx);
+    if (ril_binder_radio_parcel_get_int32(&parcel, &count)) {
+        GBinderWriter writer;
+        guint i;
+
+        gbinder_local_request_init_writer(out, &writer);
+        gbinder_writer_append_int32(&writer, grilio_request_serial(in));
+        for (i = 0; i < count; i++) {
+            const char* str;
+
+            if (ril_binder_radio_parcel_get_nullable_str(&parcel, &str)) {
+                gbinder_writer_append_hidl_string(&writer, str ? str : "");
+            } else {
+                return FALSE;
+            }
+        }
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static
+gboolean
+test_codecs_baseline_encode_ints_to_bool_int(
+    GRilIoRequest* in,
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
+{
+    GRilIoParser parser;
+    gint32 count, arg1, arg2;
+
+    ril_binder_radio_init_parser(&parser, in);
+    if (grilio_parser_get_int32(&parser, &count) && count == 2 &&
+        grilio_parser_get_int32(&parser, &arg1) &&
+        grilio_parser_get_int32(&parser, &arg2)) {
+        GBinderWriter writer;
+
+        gbinder_local_request_init_writer(out, &writer);
+        gbinder_writer_append_int32(&writer, grilio_request_serial(in));
+        gbinder_writer_append_bool(&writer, arg1);
+        gbinder_writer_append_int32(&writer, arg2);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static
+gboolean
+test_codecs_baseline_encode_deactivate_data_call(
+    GRilIoRequest* in,
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
+{
+    RilBinderRadioParcel parcel;
+    gint32 count, cid, reason;
+
+    ril_binder_radio_parcel_init(&parcel, in, ctx);
+    if (ril_binder_radio_parcel_get_int32(&parcel, &count) && count == 2 &&
+        gutil_parse_int(ril_binder_radio_parcel_get_str(&parcel), 10,
+            &cid) &&
+        gutil_parse_int(ril_binder_radio_parcel_get_str(&parcel), 10,
+            &reason)) {
+        GBinderWriter writer;
+
+        gbinder_local_request_init_writer(out, &writer);
+        gbinder_writer_append_int32(&writer, grilio_request_serial(in));
+        gbinder_writer_append_int32(&writer, cid);
+        gbinder_writer_append_bool(&writer, reason);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static
+gboolean
+test_codecs_baseline_encode_get_facility_lock(
+    GRilIoRequest* in,
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
+{
+    RilBinderRadioParcel parcel;
+    gint32 count;
+    const char* fac;
+    const char* pwd;
+    const char* aid;
+    int cls;
+
+    ril_binder_radio_parcel_init(&parcel, in, ctx);
+    if (ril_binder_radio_parcel_get_int32(&parcel, &count) && count == 4 &&
+        ril_binder_radio_parcel_get_nullable_str(&parcel, &fac) &&
+        ril_binder_radio_parcel_get_nullable_str(&parcel, &pwd) &&
+        gutil_parse_int(ril_binder_radio_parcel_get_str(&parcel), 10,
+            &cls) &&
+        ril_binder_radio_parcel_get_nullable_str(&parcel, &aid)) {
+        GBinderWriter writer;
+
+        gbinder_local_request_init_writer(out, &writer);
+        gbinder_writer_append_int32(&writer, grilio_request_serial(in));
+        gbinder_writer_append_hidl_string(&writer, fac ? fac : "");
+        gbinder_writer_append_hidl_string(&writer, pwd ? pwd : "");
+        gbinder_writer_append_int32(&writer, cls);
+        gbinder_writer_append_hidl_string(&writer, aid ? aid : "");
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static
+gboolean
+test_codecs_baseline_encode_set_facility_lock(
+    GRilIoRequest* in,
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
+{
+    RilBinderRadioParcel parcel;
+    const char* fac;
+    const char* pwd;
+    const char* aid;
+    gint32 count, lock, cls;
+
+    ril_binder_radio_parcel_init(&parcel, in, ctx);
+    if (ril_binder_radio_parcel_get_int32(&parcel, &count) && count == 5 &&
+        ril_binder_radio_parcel_get_nullable_str(&parcel, &fac) &&
+        gutil_parse_int(ril_binder_radio_parcel_get_str(&parcel), 10,
+            &lock) &&
+        ril_binder_radio_parcel_get_nullable_str(&parcel, &pwd) &&
+        gutil_parse_int(ril_binder_radio_parcel_get_str(&parcel), 10,
+            &cls) &&
+        ril_binder_radio_parcel_get_nullable_str(&parcel, &aid)) {
+        GBinderWriter writer;
+
+        gbinder_local_request_init_writer(out, &writer);
+        gbinder_writer_append_int32(&writer, grilio_request_serial(in));
+        gbinder_writer_append_hidl_string(&writer, fac ? fac : "");
+        gbinder_writer_append_bool(&writer, lock);
+        gbinder_writer_append_hidl_string(&writer, pwd ? pwd : "");
+        gbinder_writer_append_int32(&writer, cls);
+        gbinder_writer_append_hidl_string(&writer, aid ? aid : "");
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static
+gboolean
+test_codecs_baseline_encode_device_state(
+    GRilIoRequest* in,
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
+{
+    GRilIoParser parser;
+    gint32 count, type, state;
+
+    ril_binder_radio_init_parser(&parser, in);
+    if (grilio_parser_get_int32(&parser, &count) && count == 2 &&
+        grilio_parser_get_int32(&parser, &type) &&
+        grilio_parser_get_int32(&parser, &state)) {
+        ril_binder_radio_device_state_req(out, grilio_request_serial(in),
+            type, state);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static
+gboolean
+test_codecs_baseline_encode_icc_open_logical_channel(
+    GRilIoRequest* in,
+    GBinderLocalRequest* out,
+    RilBinderRadioEncodeCtx* ctx)
+{
+    RilBinderRadioParcel parcel;
+    const char* aid;
+
+    ril_binder_radio_parcel_init(&parcel, in, ctx);
+    aid = ril_binder_radio_parcel_get_str(&parcel);
+    if (aid) {
+        GBinderWriter writer;
+        gint32 p2 = 0;
+
+        ril_binder_radio_parcel_get_int32(&parcel, &p2); /* Optional? */
+        gbinder_local_request_init_writer(out, &writer);
+        gbinder_writer_append_int32(&writer, grilio_request_serial(in));
+        gbinder_writer_append_hidl_string(&writer, aid);
+        gbinder_writer_append_int32(&writer, p2);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static
+gboolean
+test_codecs_baseline_decode_int32(
+    GBinderReader* in,
+    GByteArray* out)
+{
+    gint32 value;
+
+    if (gbinder_reader_read_int32(in, &value)) {
+        grilio_encode_int32(out, value);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static
+gboolean
+test_codecs_baseline_decode_int_1(
+    GBinderReader* in,
+    GByteArray* out)
+{
+    gint32 value;
+
+    if (gbinder_reader_read_int32(in, &value)) {
+        grilio_encode_int32(out, 1);
+        grilio_encode_int32(out, value);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static
+gboolean
+test_codecs_baseline_decode_int_2(
+    GBinderReader* in,
+    GByteArray* out)
+{
+    gint32 values[2];
+
+    if (gbinder_reader_read_int32(in, values + 0) &&
+        gbinder_reader_read_int32(in, values + 1)) {
+        grilio_encode_int32(out, 2);
+        grilio_encode_int32(out, values[0]);
+        grilio_encode_int32(out, values[1]);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static
+gboolean
+test_codecs_baseline_decode_bool_to_int_array(
+    GBinderReader* in,
+    GByteArray* out)
+{
+    gint32 value;
+
+    if (gbinder_reader_read_bool(in, &value)) {
+        grilio_encode_int32(out, 1);
+        grilio_encode_int32(out, value);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static
+gboolean
+test_codecs_baseline_decode_string(
+    GBinderReader* in,
+    GByteArray* out)
+{
+    const char* str = gbinder_reader_read_hidl_string_c(in);
+
+    if (str) {
+        grilio_encode_utf8(out, str);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static
+gboolean
+test_codecs_baseline_decode_string_n(
+    GBinderReader* in,
+    GByteArray* out,
+    guint n)
+{
+    guint i;
+
+    grilio_encode_int32(out, n);
+    for (i = 0; i < n; i++) {
+        const char* str = gbinder_reader_read_hidl_string_c(in);
+
+        if (str) {
+            grilio_encode_utf8(out, str);
+        } else {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static
+gboolean
+test_codecs_baseline_decode_string_3(
+    GBinderReader* in,
+    GByteArray* out)
+{
+    return test_codecs_baseline_decode_string_n(in, out, 3);
+}
+
+static
+gboolean
+test_codecs_baseline_decode_int_array(
+    GBinderReader* in,
+    GByteArray* out)
+{
+    gboolean ok = FALSE;
+    gsize n = 0;
+    const gint32* values = gbinder_reader_read_hidl_type_vec(in, gint32, &n);
+
+    if (values) {
+        guint i;
+
+        grilio_encode_int32(out, n);
+        for (i = 0; i < n; i++) {
+            grilio_encode_int32(out, values[i]);
+        }
+        ok = TRUE;
+    }
+    return ok;
+}
+
+static
+gboolean
+test_codecs_baseline_decode_byte_array(
+    GBinderReader* in,
+    GByteArray* out)
+{
+    gsize size = 0;
+    const guint8* ptr = gbinder_reader_read_hidl_byte_vec(in, &size);
+
+    if (ptr) {
+        g_byte_array_append(out, ptr, size);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static
+gboolean
+test_codecs_baseline_decode_ims_registration_state(
+    GBinderReader* in,
+    GByteArray* out)
+{
+    gboolean reg;
+    gint32 family;
+
+    if (gbinder_reader_read_bool(in, &reg) &&
+        gbinder_reader_read_int32(in, &family)) {
+        grilio_encode_int32(out, 2); /* Number of ints to follow */
+        grilio_encode_int32(out, reg);
+        grilio_encode_int32(out, family);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static
+gboolean
+test_codecs_baseline_decode_icc_open_logical_channel(
+    GBinderReader* in,
+    GByteArray* out)
+{
+    guint32 channel;
+
+    if (gbinder_reader_read_uint32(in, &channel)) {
+        grilio_encode_int32(out, 1); /* Number of ints to follow */
+        grilio_encode_int32(out, channel);
+        /* Ignore the select response, ofono doesn't need it */
+        return TRUE;
+    }
+    return FALSE;
+}
+
+#define TEST_ENCODER(name) { #name, test_codecs_baseline_encode_##name, \
+    ril_binder_radio_encode_##name }
+#define TEST_DECODER(name) { #name, test_codecs_baseline_decode_##name, \
+    ril_binder_radio_decode_##name }
+
+static const TestCodecsEncoder test_codecs_encoders[] = {
+    TEST_ENCODER(int),
+    TEST_ENCODER(bool),
+    TEST_ENCODER(ints),
+    TEST_ENCODER(string),
+    TEST_ENCODER(strings),
+    TEST_ENCODER(ints_to_bool_int),
+    TEST_ENCODER(deactivate_data_call),
+    TEST_ENCODER(get_facility_lock),
+    TEST_ENCODER(set_facility_lock),
+    TEST_ENCODER(device_state),
+    TEST_ENCODER(icc_open_logical_channel)
+};
+
+static const TestCodecsDecoder test_codecs_decoders[] = {
+    TEST_DECODER(int32),
+    TEST_DECODER(int_1),
+    TEST_DECODER(int_2),
+    TEST_DECODER(bool_to_int_array),
+    TEST_DECODER(string),
+    TEST_DECODER(string_3),
+    TEST_DECODER(int_array),
+    TEST_DECODER(byte_array),
+    TEST_DECODER(ims_registration_state),
+    TEST_DECODER(icc_open_logical_channel)
+};
+
+/*==========================================================================*
+ * Encoders
+ *==========================================================================*/
+
+static
+GBytes*
+test_codecs_encode(
+    TestCodecsEncodeFunc encode,
+    RilBinderRadioArenaPool* pool,
+    GRilIoRequest* in,
+    gboolean* ok)
+{
+    GBinderLocalRequest* out = test_gbinder_local_request_new();
+    RilBinderRadioEncodeCtx ctx;
+    GBytes* dump;
+
+    /* Same as ril_binder_radio_run_encoder() */
+    ctx.pool = pool;
+    ctx.arena = NULL;
+    *ok = encode(in, out, &ctx);
+    if (ctx.arena) {
+        gbinder_local_request_cleanup(out, ril_binder_radio_arena_free,
+            ctx.arena);
+    }
+    dump = test_gbinder_local_request_dump(out);
+    gbinder_local_request_unref(out);
+    return dump;
+}
+
+static
+void
+test_codecs_encode_compare(
+    const TestCodecsEncoder* enc,
+    RilBinderRadioArenaPool* pool,
+    const void* data,
+    gsize size)
+{
+    GRilIoRequest* in = grilio_request_new();
+    gboolean ok1, ok2;
+    GBytes* out1;
+    GBytes* out2;
+
+    grilio_request_append_bytes(in, data, size);
+    out1 = test_codecs_encode(enc->baseline, pool, in, &ok1);
+    out2 = test_codecs_encode(enc->schema, pool, in, &ok2);
+    if (ok1 != ok2 || (ok1 && !g_bytes_equal(out1, out2))) {
+        GERR("encode_%s mismatch on %u byte(s) of input", enc->name,
+            (guint)size);
+        g_assert_cmpint(ok1, == ,ok2);
+        g_assert(g_bytes_equal(out1, out2));
+    }
+    g_bytes_unref(out1);
+    g_bytes_unref(out2);
+    grilio_request_unref(in);
+}
+
+static
+void
+test_encode(
+    gconstpointer test_data)
+{
+    const TestCodecsEncoder* enc = test_data;
+    const TestRequestType* own = test_request_type_find(enc->name);
+    RilBinderRadioMem* mem = ril_binder_radio_mem_new();
+    RilBinderRadioArenaPool* pool = ril_binder_radio_arena_pool_new(mem);
+    const TestRequestType* types;
+    guint i, n;
+    int size;
+
+    g_assert(own);
+    types = test_request_types(&n);
+    for (size = 0; size < TEST_PARCEL_SIZE_COUNT; size++) {
+        /* Every kind of request, most of them are of the wrong kind */
+        for (i = 0; i < n; i++) {
+            GRilIoRequest* req = test_request_new(types + i, size);
+
+            test_codecs_encode_compare(enc, pool, grilio_request_data(req),
+                grilio_request_size(req));
+            grilio_request_unref(req);
+        }
+    }
+
+    for (size = 0; size < TEST_PARCEL_SIZE_COUNT; size++) {
+        GRilIoRequest* req = test_request_new(own, size);
+        const gsize len = grilio_request_size(req);
+        guint8* buf = g_memdup(grilio_request_data(req), len);
+        gsize k;
+
+        /* Truncated */
+        for (k = 0; k < len; k++) {
+            test_codecs_encode_compare(enc, pool, buf, k);
+        }
+
+        /* Corrupted, one word at a time */
+        for (k = 0; k + sizeof(gint32) <= len; k += sizeof(gint32)) {
+            gint32 saved;
+
+            memcpy(&saved, buf + k, sizeof(saved));
+            for (i = 0; i < G_N_ELEMENTS(test_codecs_words); i++) {
+                memcpy(buf + k, test_codecs_words + i, sizeof(gint32));
+                test_codecs_encode_compare(enc, pool, buf, len);
+            }
+            memcpy(buf + k, &saved, sizeof(saved));
+        }
+        g_free(buf);
+        grilio_request_unref(req);
+    }
+
+    ril_binder_radio_arena_pool_unref(pool);
+    ril_binder_radio_mem_unref(mem);
+}
+
+/*==========================================================================*
+ * Decoders
+ *==========================================================================*/
+
+static
+void
+test_codecs_decode_compare(
+    const TestCodecsDecoder* dec,
+    GBinderLocalRequest* in,
+    const char* what)
+{
+    GByteArray* out1 = g_byte_array_new();
+    GByteArray* out2 = g_byte_array_new();
+    GBinderReader reader;
+    gboolean ok1, ok2;
+
+    test_gbinder_reader_init(&reader, in);
+    ok1 = dec->baseline(&reader, out1);
+    test_gbinder_reader_init(&reader, in);
+    ok2 = dec->schema(&reader, out2);
+    if (ok1 != ok2 || (ok1 && (out1->len != out2->len ||
+        memcmp(out1->data, out2->data, out1->len)))) {
+        GERR("decode_%s mismatch on %s", dec->name, what);
+        g_assert_cmpint(ok1, == ,ok2);
+        g_assert_cmpuint(out1->len, == ,out2->len);
+        g_assert(!memcmp(out1->data, out2->data, out1->len));
+    }
+    g_byte_array_free(out1, TRUE);
+    g_byte_array_free(out2, TRUE);
+}
+
+static
+gsize
+test_codecs_parcel_size(
+    GBinderLocalRequest* req)
+{
+    GBinderReader reader;
+
+    test_gbinder_reader_init(&reader, req);
+    return gbinder_reader_bytes_remaining(&reader);
+}
+
+static
+void
+test_decode(
+    gconstpointer test_data)
+{
+    const TestCodecsDecoder* dec = test_data;
+    const TestParcelType* own = test_parcel_type_find(dec->name);
+    const TestParcelType* types;
+    guint i, n;
+    int size;
+
+    g_assert(own);
+    types = test_parcel_types(&n);
+    for (size = 0; size < TEST_PARCEL_SIZE_COUNT; size++) {
+        /* Every kind of parcel, most of them are of the wrong kind */
+        for (i = 0; i < n; i++) {
+            GBinderLocalRequest* req = test_parcel_new(types + i, size);
+
+            test_codecs_decode_compare(dec, req, types[i].name);
+            gbinder_local_request_unref(req);
+        }
+    }
+
+    for (size = 0; size < TEST_PARCEL_SIZE_COUNT; size++) {
+        GBinderLocalRequest* req = test_parcel_new(own, size);
+        const gsize len = test_codecs_parcel_size(req);
+        gsize k;
+
+        gbinder_local_request_unref(req);
+
+        /* Truncated */
+        for (k = 0; k < len; k++) {
+            req = test_parcel_new(own, size);
+            test_gbinder_local_request_truncate(req, k);
+            test_codecs_decode_compare(dec, req, "truncated parcel");
+            gbinder_local_request_unref(req);
+        }
+
+        /* Corrupted, one word at a time */
+        for (k = 0; k + sizeof(gint32) <= len; k += sizeof(gint32)) {
+            for (i = 0; i < G_N_ELEMENTS(test_codecs_words); i++) {
+                GBinderWriter writer;
+
+                req = test_parcel_new(own, size);
+                gbinder_local_request_init_writer(req, &writer);
+                gbinder_writer_overwrite_int32(&writer, k,
+                    test_codecs_words[i]);
+                test_codecs_decode_compare(dec, req, "corrupted parcel");
+                gbinder_local_request_unref(req);
+            }
+        }
+    }
+}
+
+/*==========================================================================*
+ * Common
+ *==========================================================================*/
+
+#define TEST_(name) "/codecs/" name
+
+int main(int argc, char* argv[])
+{
+    guint i;
+
+    G_GNUC_BEGIN_IGNORE_DEPRECATIONS;
+    g_type_init();
+    G_GNUC_END_IGNORE_DEPRECATIONS;
+    g_test_init(&argc, &argv, NULL);
+    for (i = 0; i < G_N_ELEMENTS(test_codecs_encoders); i++) {
+        const TestCodecsEncoder* enc = test_codecs_encoders + i;
+        char* path = g_strconcat(TEST_("encode/"), enc->name, NULL);
+
+        g_test_add_data_func(path, enc, test_encode);
+        g_free(path);
+    }
+    for (i = 0; i < G_N_ELEMENTS(test_codecs_decoders); i++) {
+        const TestCodecsDecoder* dec = test_codecs_decoders + i;
+        char* path = g_strconcat(TEST_("decode/"), dec->name, NULL);
+
+        g_test_add_data_func(path, dec, test_decode);
+        g_free(path);
+    }
+    test_init(&test_opt, argc, argv);
+    return g_test_run();
+}
+
+/*
+ * Local Variables:
+ * mode: C
+ * c-basic-offset: 4
+ * indent-tabs-mode: nil
+ * End:
+ */
@@ -0,0 +1,288 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Signal strength, call list, registration state and acknowledgements
+ * arrive all the time and must not allocate anything once the pooled
+ * buffers have grown to the right size. Allocations are counted by
+ * ril_binder_alloc.c which is linked into this test.
+ */
+
+#include "test_common.h"
+#include "test_gbinder.h"
+#include "test_parcels.h"
+#include "test_radio_instance.h"
+
+/* Radio handlers are static */
+#include "ril_binder_radio.c"
+
+#define TEST_HOT_PATH_SERIAL (1)
+#define TEST_HOT_PATH_COUNT (100)
+
+static TestOpt test_opt;
+
+/* ril_binder_alloc.c */
+extern unsigned long ril_binder_alloc_count(void);
+
+typedef struct test_hot_path {
+    const char* name;
+    const char* parcel;
+    RADIO_IND ind;      /* Either ind */
+    RADIO_RESP resp;    /* or resp is non-zero */
+} TestHotPath;
+
+static const TestHotPath test_hot_paths[] = {
+    { "ind/signal_strength", "signal_strength",
+      RADIO_IND_CURRENT_SIGNAL_STRENGTH, 0 },
+    { "ind/signal_strength_1_2", "signal_strength_1_2",
+      RADIO_IND_CURRENT_SIGNAL_STRENGTH_1_2, 0 },
+    { "ind/signal_strength_1_4", "signal_strength_1_4",
+      RADIO_IND_CURRENT_SIGNAL_STRENGTH_1_4, 0 },
+    { "resp/signal_strength", "signal_strength",
+      0, RADIO_RESP_GET_SIGNAL_STRENGTH },
+    { "resp/signal_strength_1_2", "signal_strength_1_2",
+      0, RADIO_RESP_GET_SIGNAL_STRENGTH_1_2 },
+    { "resp/signal_strength_1_4", "signal_strength_1_4",
+      0, RADIO_RESP_GET_SIGNAL_STRENGTH_1_4 },
+    { "resp/call_list", "call_list",
+      0, RADIO_RESP_GET_CURRENT_CALLS },
+    { "resp/call_list_1_2", "call_list_1_2",
+      0, RADIO_RESP_GET_CURRENT_CALLS_1_2 },
+    { "resp/voice_reg_state", "voice_reg_state",
+      0, RADIO_RESP_GET_VOICE_REGISTRATION_STATE },
+    { "resp/voice_reg_state_1_2", "voice_reg_state",
+      0, RADIO_RESP_GET_VOICE_REGISTRATION_STATE_1_2 },
+    { "resp/data_reg_state", "data_reg_state",
+      0, RADIO_RESP_GET_DATA_REGISTRATION_STATE },
+    { "resp/data_reg_state_1_2", "data_reg_state",
+      0, RADIO_RESP_GET_DATA_REGISTRATION_STATE_1_2 },
+    { "resp/data_reg_state_1_4", "data_reg_state_1_4",
+      0, RADIO_RESP_GET_DATA_REGISTRATION_STATE_RESPONSE_1_4 }
+};
+
+/*==========================================================================*
+ * Common
+ *==========================================================================*/
+
+static
+GRilIoTransport*
+test_hot_path_transport_new(
+    void)
+{
+    GHashTable* args = g_hash_table_new(g_str_hash, g_str_equal);
+    GRilIoTransport* transport;
+    RadioInstance* radio;
+
+    /* The newest interface knows all the transactions */
+    g_hash_table_insert(args, RIL_BINDER_KEY_INTERFACE,
+        (gpointer)ril_binder_radio_interface_name(RADIO_INTERFACE_1_4));
+    transport = ril_binder_radio_new(args);
+    g_hash_table_destroy(args);
+    g_assert(transport);
+    radio = test_radio_instance_last();
+    g_assert(radio);
+    test_radio_instance_set_record(radio, FALSE);
+    test_radio_instance_connect(radio);
+    return transport;
+}
+
+/*
+ * The handlers are invoked directly rather than through the loopback
+ * RadioInstance, whose own dispatch allocates memory. Each response is
+ * preceded by latency_start() as if the request had just been submitted,
+ * so that the response is matched with it just like the real one would.
+ */
+
+static
+void
+test_hot_path_call(
+    RilBinderRadio* self,
+    const TestHotPath* test,
+    const char* name,
+    GBinderLocalRequest* req)
+{
+    GBinderReader reader;
+
+    test_gbinder_reader_init(&reader, req);
+    if (test->ind) {
+        g_assert(ril_binder_radio_indication_handler(self->radio, test->ind,
+            RADIO_IND_UNSOLICITED, &reader, self));
+    } else {
+        RadioResponseInfo info;
+
+        memset(&info, 0, sizeof(info));
+        info.type = RADIO_RESP_SOLICITED;
+        info.serial = TEST_HOT_PATH_SERIAL;
+        info.error = RADIO_ERROR_NONE;
+        ril_binder_radio_latency_start(self, name, TEST_HOT_PATH_SERIAL);
+        g_assert(ril_binder_radio_response_handler(self->radio, test->resp,
+            &info, &reader, self));
+    }
+}
+
+/*==========================================================================*
+ * path
+ *==========================================================================*/
+
+static
+void
+test_path(
+    gconstpointer data)
+{
+    const TestHotPath* test = data;
+    const TestParcelType* type = test_parcel_type_find(test->parcel);
+    GRilIoTransport* transport = test_hot_path_transport_new();
+    RilBinderRadio* self = RIL_BINDER_RADIO(transport);
+    const char* name;
+    guint expected = 0;
+    int size;
+
+    if (test->ind) {
+        const RilBinderRadioEvent* event =
+            ril_binder_radio_tables_unsol(self->priv->tables, test->ind);
+
+        g_assert(event);
+        name = event->name;
+    } else {
+        const RilBinderRadioCall* call =
+            ril_binder_radio_tables_resp(self->priv->tables, test->resp);
+
+        g_assert(call);
+        name = call->name;
+    }
+
+    g_assert(type);
+    for (size = 0; size < TEST_PARCEL_SIZE_COUNT; size++) {
+        GBinderLocalRequest* req = test_parcel_new(type, size);
+        unsigned long allocs;
+        int i;
+
+        /* Let the buffers grow and the counters get created */
+        test_hot_path_call(self, test, name, req);
+        allocs = ril_binder_alloc_count();
+        for (i = 0; i < TEST_HOT_PATH_COUNT; i++) {
+            test_hot_path_call(self, test, name, req);
+        }
+        allocs = ril_binder_alloc_count() - allocs;
+        if (allocs) {
+            GERR("%s (%s): %lu allocations", name,
+                test_parcel_size_name(size), allocs);
+        }
+        g_assert_cmpuint(allocs, == ,0);
+        gbinder_local_request_unref(req);
+        expected += TEST_HOT_PATH_COUNT + 1;
+    }
+
+    if (!test->ind) {
+        RilBinderRadioLatency latency;
+
+        /* Make sure that the responses have been matched */
+        g_assert(ril_binder_radio_latency_get(transport, name, &latency));
+        g_assert_cmpuint(latency.resp_count, == ,expected);
+    }
+    grilio_transport_unref(transport);
+}
+
+/*==========================================================================*
+ * ack
+ *==========================================================================*/
+
+static
+void
+test_ack(
+    void)
+{
+    static const char name[] = "getSignalStrength";
+    GRilIoTransport* transport = test_hot_path_transport_new();
+    RilBinderRadio* self = RIL_BINDER_RADIO(transport);
+    RilBinderRadioLatency latency;
+    unsigned long allocs;
+    int i;
+
+    ril_binder_radio_latency_start(self, name, TEST_HOT_PATH_SERIAL);
+    ril_binder_radio_ack_handler(self->radio, TEST_HOT_PATH_SERIAL, self);
+    allocs = ril_binder_alloc_count();
+    for (i = 0; i < TEST_HOT_PATH_COUNT; i++) {
+        ril_binder_radio_latency_start(self, name, TEST_HOT_PATH_SERIAL);
+        ril_binder_radio_ack_handler(self->radio, TEST_HOT_PATH_SERIAL, self);
+    }
+    allocs = ril_binder_alloc_count() - allocs;
+    g_assert_cmpuint(allocs, == ,0);
+
+    /* Make sure that the acks have been matched */
+    g_assert(ril_binder_radio_latency_get(transport, name, &latency));
+    g_assert_cmpuint(latency.ack_count, == ,TEST_HOT_PATH_COUNT + 1);
+    grilio_transport_unref(transport);
+}
+
+/*==========================================================================*
+ * Common
+ *==========================================================================*/
+
+#define TEST_(name) "/hot_path/" name
+
+int main(int argc, char* argv[])
+{
+    guint i;
+
+    /*
+     * Otherwise GSlice (before glib 2.76) serves allocations from its
+     * own magazines, which are invisible to the allocation counter.
+     * Must be done before anything gets allocated from GSlice.
+     */
+    g_setenv("G_SLICE", "always-malloc", TRUE);
+
+    G_GNUC_BEGIN_IGNORE_DEPRECATIONS;
+    g_type_init();
+    G_GNUC_END_IGNORE_DEPRECATIONS;
+    g_test_init(&argc, &argv, NULL);
+    for (i = 0; i < G_N_ELEMENTS(test_hot_paths); i++) {
+        const TestHotPath* test = test_hot_paths + i;
+        char* path = g_strconcat(TEST_(""), test->name, NULL);
+
+        g_test_add_data_func(path, test, test_path);
+        g_free(path);
+    }
+    g_test_add_func(TEST_("ack"), test_ack);
+    test_init(&test_opt, argc, argv);
+
+    /* Debug output allocates memory, keep it quiet even with -v */
+    gutil_log_default.level = GLOG_LEVEL_NONE;
+    return g_test_run();
+}
+
+/*
+ * Local Variables:
+ * mode: C
+ * c-basic-offset: 4
+ * indent-tabs-mode: nil
+ * End:
+ */
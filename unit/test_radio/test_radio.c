@@ -0,0 +1,493 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * You may use this file under the terms of BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *   3. Neither the names of the copyright holders nor the names of its
+ *      contributors may be used to endorse or promote products derived
+ *      from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_common.h"
+#include "test_radio_instance.h"
+
+#include "ril_binder_radio.h"
+
+#include <ofono/ril-constants.h>
+
+#include <grilio_channel.h>
+#include <grilio_parser.h>
+#include <grilio_transport.h>
+
+#include <gbinder.h>
+
+#define TEST_BASEBAND "Loopback 1.0"
+
+static TestOpt test_opt;
+
+typedef struct test_data {
+    GMainLoop* loop;
+    GRilIoTransport* transport;
+    GRilIoChannel* io;
+    RadioInstance* radio;
+    guint count;
+    guint expected;
+    guint disconnected;
+} TestData;
+
+typedef struct test_call {
+    TestData* test;
+    int status;
+    gboolean done;
+} TestCall;
+
+static
+void
+test_write_baseband(
+    GBinderWriter* writer,
+    gpointer user_data)
+{
+    gbinder_writer_append_hidl_string(writer, TEST_BASEBAND);
+}
+
+static const TestRadioResponse test_baseband_response = {
+    RADIO_REQ_GET_BASEBAND_VERSION, RADIO_RESP_GET_BASEBAND_VERSION,
+    RADIO_RESP_SOLICITED, RADIO_ERROR_NONE, test_write_baseband, NULL
+};
+
+static
+void
+test_setup(
+    TestData* test,
+    const char* const* args)
+{
+    GHashTable* table = g_hash_table_new(g_str_hash, g_str_equal);
+
+    /* Key/value pairs, NULL terminated */
+    while (args && args[0]) {
+        g_hash_table_insert(table, (gpointer)args[0], (gpointer)args[1]);
+        args += 2;
+    }
+    memset(test, 0, sizeof(*test));
+    test->loop = g_main_loop_new(NULL, FALSE);
+    test->transport = ril_binder_radio_new(table);
+    g_assert(test->transport);
+    test->radio = test_radio_instance_last();
+    g_assert(test->radio);
+    test->io = grilio_channel_new(test->transport);
+    g_assert(test->io);
+    test_radio_instance_connect(test->radio);
+    g_assert(test->transport->connected);
+    test_radio_instance_script(test->radio, &test_baseband_response, 1);
+    g_hash_table_destroy(table);
+}
+
+static
+void
+test_teardown(
+    TestData* test)
+{
+    grilio_channel_shutdown(test->io, FALSE);
+    grilio_channel_unref(test->io);
+    grilio_transport_unref(test->transport);
+    g_main_loop_unref(test->loop);
+}
+
+static
+void
+test_call_done(
+    GRilIoChannel* io,
+    int status,
+    const void* data,
+    guint len,
+    void* user_data)
+{
+    TestCall* call = user_data;
+    TestData* test = call->test;
+
+    g_assert(!call->done);
+    call->done = TRUE;
+    call->status = status;
+    if (status == RIL_E_SUCCESS) {
+        GRilIoParser rilp;
+        char* str;
+
+        grilio_parser_init(&rilp, data, len);
+        str = grilio_parser_get_utf8(&rilp);
+        g_assert_cmpstr(str, == ,TEST_BASEBAND);
+        g_free(str);
+    }
+    if (++(test->count) == test->expected) {
+        test_quit_later(test->loop);
+    }
+}
+
+static
+void
+test_call(
+    TestData* test,
+    TestCall* call)
+{
+    guint id;
+
+    memset(call, 0, sizeof(*call));
+    call->test = test;
+    call->status = -1;
+    id = grilio_channel_send_request_full(test->io, NULL,
+        RIL_REQUEST_BASEBAND_VERSION, test_call_done, NULL, call);
+    g_assert(id);
+}
+
+/*==========================================================================*
+ * connect
+ *==========================================================================*/
+
+static
+void
+test_connect(
+    void)
+{
+    static const char* const args[] = {
+        "interface", "radio@1.2",
+        NULL
+    };
+    TestData test;
+
+    test_setup(&test, args);
+    g_assert_cmpint(test.radio->version, == ,RADIO_INTERFACE_1_2);
+    g_assert(test_radio_instance_enabled(test.radio) == test.io->enabled);
+    test_teardown(&test);
+}
+
+/*==========================================================================*
+ * response
+ *==========================================================================*/
+
+static
+void
+test_response_run(
+    const char* const* args)
+{
+    TestData test;
+    TestCall call;
+    const TestRadioTx* tx;
+
+    test_setup(&test, args);
+    test.expected = 1;
+    test_call(&test, &call);
+    test_run(&test_opt, test.loop);
+    g_assert(call.done);
+    g_assert_cmpint(call.status, == ,RIL_E_SUCCESS);
+
+    /* One getBasebandVersion transaction */
+    g_assert_cmpuint(test_radio_instance_tx_count(test.radio), == ,1);
+    tx = test_radio_instance_tx(test.radio, 0);
+    g_assert_cmpuint(tx->code, == ,RADIO_REQ_GET_BASEBAND_VERSION);
+    g_assert_cmpuint(test_radio_instance_pending(test.radio), == ,0);
+    test_teardown(&test);
+}
+
+static
+void
+test_response(
+    void)
+{
+    test_response_run(NULL);
+}
+
+static
+void
+test_response_async(
+    void)
+{
+    static const char* const args[] = {
+        "async", "on",
+        NULL
+    };
+
+    test_response_run(args);
+}
+
+static
+void
+test_response_batch(
+    void)
+{
+    static const char* const args[] = {
+        "batch", "on",
+        NULL
+    };
+
+    test_response_run(args);
+}
+
+/*==========================================================================*
+ * batch_stats
+ *==========================================================================*/
+
+static
+void
+test_batch_stats(
+    void)
+{
+    static const char* const args[] = {
+        "batch", "on",
+        NULL
+    };
+    RilBinderRadioBatchStats stats;
+    TestData test;
+    TestCall call;
+    guint i;
+
+    g_assert_cmpuint(ril_binder_radio_batch_bucket_limit(0), == ,1);
+    g_assert_cmpuint(ril_binder_radio_batch_bucket_limit(2), == ,4);
+    g_assert_cmpuint(ril_binder_radio_batch_bucket_limit
+        (RIL_BINDER_RADIO_BATCH_BUCKETS - 1), == ,G_MAXUINT);
+    g_assert_cmpuint(ril_binder_radio_batch_bucket_limit
+        (RIL_BINDER_RADIO_BATCH_BUCKETS), == ,0);
+    g_assert(!ril_binder_radio_batch_stats(NULL, &stats));
+
+    test_setup(&test, args);
+    test.expected = 1;
+    test_call(&test, &call);
+    test_run(&test_opt, test.loop);
+    g_assert(call.done);
+
+    /* One flush of a single request */
+    g_assert(ril_binder_radio_batch_stats(test.transport, &stats));
+    g_assert_cmpuint(stats.flushes, == ,1);
+    g_assert_cmpuint(stats.hist[0], == ,1);
+    for (i = 1; i < RIL_BINDER_RADIO_BATCH_BUCKETS; i++) {
+        g_assert_cmpuint(stats.hist[i], == ,0);
+    }
+
+    ril_binder_radio_batch_stats_reset(test.transport);
+    g_assert(ril_binder_radio_batch_stats(test.transport, &stats));
+    g_assert_cmpuint(stats.flushes, == ,0);
+    g_assert_cmpuint(stats.hist[0], == ,0);
+    test_teardown(&test);
+}
+
+/*==========================================================================*
+ * jitter
+ *==========================================================================*/
+
+#define TEST_JITTER_CALLS (20)
+
+static
+void
+test_jitter(
+    void)
+{
+    TestData test;
+    TestCall call[TEST_JITTER_CALLS];
+    int i;
+
+    test_setup(&test, NULL);
+    test_radio_instance_set_delay(test.radio, 2, 10);
+    test.expected = TEST_JITTER_CALLS;
+    for (i = 0; i < TEST_JITTER_CALLS; i++) {
+        test_call(&test, call + i);
+    }
+    g_assert_cmpuint(test_radio_instance_pending(test.radio), == ,
+        TEST_JITTER_CALLS);
+    test_run(&test_opt, test.loop);
+
+    /* Each request has completed exactly once */
+    for (i = 0; i < TEST_JITTER_CALLS; i++) {
+        g_assert(call[i].done);
+        g_assert_cmpint(call[i].status, == ,RIL_E_SUCCESS);
+    }
+    test_teardown(&test);
+}
+
+/*==========================================================================*
+ * fail
+ *==========================================================================*/
+
+static
+void
+test_fail(
+    void)
+{
+    TestData test;
+    TestCall call[2];
+
+    test_setup(&test, NULL);
+    test_radio_instance_fail_requests(test.radio, 1);
+    test.expected = 2;
+    test_call(&test, call);
+    test_call(&test, call + 1);
+    test_run(&test_opt, test.loop);
+    g_assert_cmpint(call[0].status, == ,RIL_E_GENERIC_FAILURE);
+    g_assert_cmpint(call[1].status, == ,RIL_E_SUCCESS);
+    test_teardown(&test);
+}
+
+/*==========================================================================*
+ * storm
+ *==========================================================================*/
+
+static
+void
+test_storm_event(
+    GRilIoChannel* io,
+    guint code,
+    const void* data,
+    guint len,
+    void* user_data)
+{
+    TestData* test = user_data;
+
+    g_assert_cmpuint(code, == ,RIL_UNSOL_RESPONSE_VOICE_NETWORK_STATE_CHANGED);
+    test->count++;
+}
+
+static
+void
+test_storm_done(
+    gpointer user_data)
+{
+    TestData* test = user_data;
+
+    test_quit_later(test->loop);
+}
+
+static
+void
+test_storm_run(
+    guint count,
+    guint interval_ms,
+    guint jitter_ms)
+{
+    TestData test;
+    TestRadioStorm storm;
+    gulong id;
+
+    test_setup(&test, NULL);
+    test_radio_instance_set_delay(test.radio, 0, jitter_ms);
+    id = grilio_channel_add_unsol_event_handler(test.io, test_storm_event,
+        RIL_UNSOL_RESPONSE_VOICE_NETWORK_STATE_CHANGED, &test);
+
+    memset(&storm, 0, sizeof(storm));
+    storm.code = RADIO_IND_NETWORK_STATE_CHANGED;
+    storm.type = RADIO_IND_UNSOLICITED;
+    storm.count = count;
+    storm.interval_ms = interval_ms;
+    test_radio_instance_storm(test.radio, &storm, test_storm_done, &test);
+    test_run(&test_opt, test.loop);
+    g_assert_cmpuint(test.count, == ,count);
+
+    grilio_channel_remove_handler(test.io, id);
+    test_teardown(&test);
+}
+
+static
+void
+test_storm(
+    void)
+{
+    test_storm_run(1000, 0, 0);
+}
+
+static
+void
+test_storm_jitter(
+    void)
+{
+    test_storm_run(20, 1, 2);
+}
+
+/*==========================================================================*
+ * death
+ *==========================================================================*/
+
+static
+void
+test_death_disconnected(
+    GRilIoChannel* io,
+    void* user_data)
+{
+    TestData* test = user_data;
+
+    test->disconnected++;
+}
+
+static
+void
+test_death(
+    void)
+{
+    TestData test;
+    TestCall call;
+    gulong id;
+
+    test_setup(&test, NULL);
+    test_radio_instance_set_delay(test.radio, 1000, 0);
+    id = grilio_channel_add_disconnected_handler(test.io,
+        test_death_disconnected, &test);
+
+    /* The scheduled response gets dropped */
+    test_call(&test, &call);
+    g_assert_cmpuint(test_radio_instance_pending(test.radio), == ,1);
+    test_radio_instance_die(test.radio);
+    test.radio = NULL; /* The transport has dropped it */
+    test_quit_later(test.loop);
+    test_run(&test_opt, test.loop);
+    g_assert_cmpuint(test.disconnected, == ,1);
+    g_assert(!test.transport->connected);
+
+    grilio_channel_remove_handler(test.io, id);
+    test_teardown(&test);
+}
+
+#define TEST_(name) "/binder_radio/" name
+
+int main(int argc, char* argv[])
+{
+    G_GNUC_BEGIN_IGNORE_DEPRECATIONS;
+    g_type_init();
+    G_GNUC_END_IGNORE_DEPRECATIONS;
+    g_test_init(&argc, &argv, NULL);
+    g_test_add_func(TEST_("connect"), test_connect);
+    g_test_add_func(TEST_("response"), test_response);
+    g_test_add_func(TEST_("response_async"), test_response_async);
+    g_test_add_func(TEST_("response_batch"), test_response_batch);
+    g_test_add_func(TEST_("batch_stats"), test_batch_stats);
+    g_test_add_func(TEST_("jitter"), test_jitter);
+    g_test_add_func(TEST_("fail"), test_fail);
+    g_test_add_func(TEST_("storm"), test_storm);
+    g_test_add_func(TEST_("storm_jitter"), test_storm_jitter);
+    g_test_add_func(TEST_("death"), test_death);
+    test_init(&test_opt, argc, argv);
+    return g_test_run();
+}
+
+/*
+ * Local Variables:
+ * mode: C
+ * c-basic-offset: 4
+ * indent-tabs-mode: nil
+ * End:
+ */